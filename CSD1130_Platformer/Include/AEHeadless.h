@@ -0,0 +1,72 @@
+/******************************************************************************/
+/*!
+\file		AEHeadless.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_AE_HEADLESS_H_
+#define CSD1130_AE_HEADLESS_H_
+
+// ---------------------------------------------------------------------------
+// includes
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// the engine headers export their functions from the engine dll,
+// in a headless build they are plain functions from AEHeadless.cpp
+#include "AEExport.h"
+#undef	AE_API
+#define	AE_API
+
+#include "AETypes.h"
+#include "AEMath.h"
+
+typedef struct AEGfxVertexList AEGfxVertexList;
+
+// ---------------------------------------------------------------------------
+// assert defines, same as AEEngine.h without the message box
+
+#ifndef AE_FINAL
+
+#define AE_ASSERT_MESG(x, ...)												\
+{																			\
+	if((x) == 0)															\
+	{																		\
+		PRINT("AE_ASSERT_MESG: %s\nLine: %d\nFunc: %s\nFile: %s\n",			\
+			#x, __LINE__, __FUNCTION__, __FILE__);							\
+		PRINT("Mesg: ");													\
+		PRINT(__VA_ARGS__);													\
+		PRINT("\n");														\
+		exit(1);															\
+	}																		\
+}
+
+#define AE_ASSERT_PARM(x)													\
+{																			\
+	if((x) == 0)															\
+	{																		\
+		PRINT("AE_ASSERT_PARM: %s\nLine: %d\nFunc: %s\nFile: %s\n",			\
+			#x, __LINE__, __FUNCTION__, __FILE__);							\
+		exit(1);															\
+	}																		\
+}
+
+#else // AE_FINAL
+
+#define AE_ASSERT_MESG(x, ...)
+#define AE_ASSERT_PARM(x)
+
+#endif // AE_FINAL
+
+
+#endif // CSD1130_AE_HEADLESS_H_
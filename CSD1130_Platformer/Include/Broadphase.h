@@ -0,0 +1,89 @@
+/******************************************************************************/
+/*!
+\file		Broadphase.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Uniform grid broadphase for rect-rect collision.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_BROADPHASE_H_
+#define CSD1130_BROADPHASE_H_
+
+/**************************************************************************/
+/*!
+	Two boxes that overlap, by the ids they were added with
+	*/
+/**************************************************************************/
+struct BroadphasePair
+{
+	unsigned int	a;
+	unsigned int	b;
+};
+
+/**************************************************************************/
+/*!
+	Cells covered by a box, inclusive
+	*/
+/**************************************************************************/
+struct BroadphaseCellRange
+{
+	int				x0, y0;
+	int				x1, y1;
+};
+
+/**************************************************************************/
+/*!
+	Grid of cells starting at the origin. Boxes outside of the grid are
+	kept in the border cells.
+	The boxes are bucketed by cell again every time pairs are found, so
+	nothing has to be removed when a box moves. Cells are found through a
+	hash table sized to the boxes, so empty cells cost neither time nor
+	memory. A grid with fewer cells than the table would have is indexed
+	directly instead.
+	*/
+/**************************************************************************/
+struct Broadphase
+{
+	float				cellSize;
+	int					width;			// number of cells along x
+	int					height;			// number of cells along y
+
+	unsigned int		*pCellKey;		// cell held by each hash slot, or BROADPHASE_CELL_NONE
+	unsigned int		*pCellStart;	// offsets into pCellItem per hash slot, 0 while no pairs are being found
+	unsigned int		cellHashMax;	// hash slots, a power of 2 unless the cells are the slots
+	bool				cellDirect;		// slot i holds cell i, there is a slot for every cell
+
+	unsigned int		*pCellList;		// hash slots of the cells holding at least one box, in the order they were first covered
+	unsigned int		cellListMax;
+
+	unsigned int		*pCellItem;		// item indices, sorted by cell
+	unsigned int		cellItemMax;
+
+	unsigned int		*pEntrySlot;	// hash slot of each cell an item covers, item by item
+	unsigned int		entrySlotMax;
+
+	unsigned int		*pItemId;
+	AABB				*pItemBox;
+	BroadphaseCellRange	*pItemRange;
+	unsigned int		itemNum;
+	unsigned int		itemMax;
+
+	BroadphasePair		*pPair;
+	unsigned int		pairNum;
+	unsigned int		pairMax;
+};
+
+bool			BroadphaseInit		(Broadphase *pBroadphase, float cellSize, int width, int height);
+void			BroadphaseFree		(Broadphase *pBroadphase);
+void			BroadphaseClear		(Broadphase *pBroadphase);
+bool			BroadphaseAdd		(Broadphase *pBroadphase, unsigned int id, const AABB &box);
+unsigned int	BroadphaseFindPairs	(Broadphase *pBroadphase);
+
+
+#endif // CSD1130_BROADPHASE_H_
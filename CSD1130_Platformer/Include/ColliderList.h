@@ -0,0 +1,45 @@
+/******************************************************************************/
+/*!
+\file		ColliderList.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Collision cells of the map merged into a few static rectangles.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+/******************************************************************************/
+
+#ifndef CSD1130_COLLIDER_LIST_H_
+#define CSD1130_COLLIDER_LIST_H_
+
+#define COLLIDER_LIST_HEIGHT_MAX	16		// rows a rectangle spans at most
+
+/**************************************************************************/
+/*!
+	Rectangles in map units that cover every collision cell exactly once,
+	their corners are on the grid. They are sorted by min.y and none is
+	taller than COLLIDER_LIST_HEIGHT_MAX, so a query binary-searches the
+	first rectangle that can reach the box and stops at the first one
+	above it.
+	*/
+/**************************************************************************/
+struct ColliderList
+{
+	AABB			*pRect;
+	unsigned int	num;
+	unsigned int	max;		// allocated length of pRect
+	unsigned int	cellNum;	// collision cells the rectangles cover
+};
+
+bool			ColliderListBuild	(ColliderList *pList, const CollisionMap &map);
+bool			ColliderListSetCell	(ColliderList *pList, int X, int Y, bool collision);
+void			ColliderListFree	(ColliderList *pList);
+unsigned int	ColliderListFirst	(const ColliderList &list, float y);
+bool			ColliderListOverlap	(const ColliderList &list, const AABB &box);
+float			ColliderListSweep	(const ColliderList &list, const AABB &box, const AEVec2 &delta, AEVec2 *pNormal);
+
+
+#endif // CSD1130_COLLIDER_LIST_H_
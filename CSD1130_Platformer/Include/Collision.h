@@ -26,8 +26,57 @@ struct AABB
 	AEVec2	max;
 };
 
+/**************************************************************************/
+/*!
+	Boxes and velocities stored as one array per component
+	*/
+/**************************************************************************/
+struct AABBBatch
+{
+	const float		*pMinX;
+	const float		*pMinY;
+	const float		*pMaxX;
+	const float		*pMaxY;
+	const float		*pVelX;
+	const float		*pVelY;
+	unsigned int	num;
+};
+
+/**************************************************************************/
+/*!
+	When and how two moving rectangles touch during a frame
+	*/
+/**************************************************************************/
+struct RectRectContact
+{
+	float	tFirst;		// first time they touch, 0 if they already overlap
+	float	tLast;		// last time they touch, no later than g_dt
+	AEVec2	normal;		// axis they meet along, from box 1 to box 2
+};
+
+/**************************************************************************/
+/*!
+	A contact of a batch test and the box of the batch it was with
+	*/
+/**************************************************************************/
+struct RectRectHit
+{
+	RectRectContact	contact;
+	unsigned int	index;
+};
+
 bool CollisionIntersection_RectRect(const AABB &aabb1, const AEVec2 &vel1, 
 									const AABB &aabb2, const AEVec2 &vel2);
 
+bool CollisionIntersection_RectRectSwept(const AABB &aabb1, const AEVec2 &vel1,
+										 const AABB &aabb2, const AEVec2 &vel2,
+										 RectRectContact *pContact);
+
+unsigned int CollisionIntersection_RectRectBatch(const AABB &aabb1, const AEVec2 &vel1,
+												 const AABBBatch &batch, unsigned int *pHitMask);
+
+unsigned int CollisionIntersection_RectRectSweptBatch(const AABB &aabb1, const AEVec2 &vel1,
+													  const AABBBatch &batch, RectRectHit *pHit);
+
 
 #endif // CSD1130_COLLISION_H_
\ No newline at end of file
@@ -0,0 +1,68 @@
+/******************************************************************************/
+/*!
+\file		CollisionMap.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Binary collision map stored as one bit per cell.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_COLLISION_MAP_H_
+#define CSD1130_COLLISION_MAP_H_
+
+/**************************************************************************/
+/*!
+	One bit per cell, 1 for a collision cell. Rows are stored one after
+	the other from y = 0 and each row starts on a new word, bit x % 32 of
+	word x / 32 of the row is cell (x, y). A 4096 x 4096 map takes 2 MB.
+	*/
+/**************************************************************************/
+struct CollisionMap
+{
+	unsigned int	*pWords;
+	int				width;
+	int				height;
+	unsigned int	rowWords;		// words per row
+};
+
+bool	CollisionMapInit(CollisionMap *pMap, int width, int height);
+void	CollisionMapFree(CollisionMap *pMap);
+float	CollisionMapSweep(const CollisionMap &map, const AABB &box, const AEVec2 &delta, AEVec2 *pNormal);
+
+/**************************************************************************/
+/*!
+	Value of cell (X, Y), 0 outside of the map.
+	The bounds are checked without branching: a negative coordinate
+	becomes a large unsigned one, so one compare per axis covers both
+	ends, and a cell outside reads word 0 and masks the bit away.
+	*/
+/**************************************************************************/
+inline int CollisionMapGet(const CollisionMap &map, int X, int Y)
+{
+	unsigned int inside	= ((unsigned int)X < (unsigned int)map.width) & ((unsigned int)Y < (unsigned int)map.height);
+	unsigned int word	= ((unsigned int)Y * map.rowWords + ((unsigned int)X >> 5)) & (0u - inside);
+
+	return (int)(map.pWords[word] >> ((unsigned int)X & 31) & inside);
+}
+
+/**************************************************************************/
+/*!
+	Sets cell (X, Y) to 1 if value is not 0, or clears it, the cell must
+	be inside of the map
+	*/
+/**************************************************************************/
+inline void CollisionMapSet(CollisionMap *pMap, int X, int Y, int value)
+{
+	unsigned int *pWord	= pMap->pWords + Y * pMap->rowWords + (X >> 5);
+	unsigned int bit	= 1u << (X & 31);
+
+	*pWord = value ? *pWord | bit : *pWord & ~bit;
+}
+
+
+#endif // CSD1130_COLLISION_MAP_H_
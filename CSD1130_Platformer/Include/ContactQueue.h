@@ -0,0 +1,94 @@
+/******************************************************************************/
+/*!
+\file		ContactQueue.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Contact events written by the rect-rect narrowphase and read by
+			the gameplay response afterwards.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+/******************************************************************************/
+
+#ifndef CSD1130_CONTACT_QUEUE_H_
+#define CSD1130_CONTACT_QUEUE_H_
+
+enum CONTACT_TYPE
+{
+	CONTACT_NONE = 0,		// the slot was tested and does not touch
+	CONTACT_ENTER,			// touching, did not touch last frame
+	CONTACT_STAY,			// touching, touched last frame too
+	CONTACT_EXIT			// touched last frame, does not touch any more
+};
+
+/**************************************************************************/
+/*!
+	One contact between two ids, a is the one that reacts
+	*/
+/**************************************************************************/
+struct ContactEvent
+{
+	unsigned int	a;
+	unsigned int	b;
+	CONTACT_TYPE	type;
+	float			timeOfImpact;	// from the start of the frame, 0 for boxes that already touch
+	AEVec2			normal;			// axis they met along, from a to b
+	unsigned int	slot;			// slot the pair was tested in
+};
+
+/**************************************************************************/
+/*!
+	Every frame ContactQueueBegin hands out one slot per pair to test. The
+	narrowphase fills the slots with ContactQueueWrite, each slot is only
+	written by the one that tests its pair, so the slots can be split
+	between threads. ContactQueueEnd then packs the touching slots to the
+	front in slot order, tells enter from stay against the pairs that
+	touched last frame, and appends an exit for every pair that stopped.
+	All memory is reserved by ContactQueueBegin.
+	*/
+/**************************************************************************/
+struct ContactQueue
+{
+	ContactEvent		*pEvent;
+	unsigned int		slotNum;		// slots handed out by ContactQueueBegin
+	unsigned int		eventNum;		// events after ContactQueueEnd
+	unsigned int		touchNum;		// enter and stay events, the exits follow them
+	unsigned int		eventMax;
+
+	unsigned long long	*pPrev;			// pairs that touched last frame, sorted, a in the high half
+	unsigned long long	*pCurr;			// pairs that touch this frame, becomes pPrev
+	unsigned char		*pPrevSeen;		// per pPrev entry, set when it still touches
+	unsigned int		prevNum;
+	unsigned int		pairMax;		// length of pPrev, pCurr and pPrevSeen
+};
+
+bool			ContactQueueInit	(ContactQueue *pQueue);
+void			ContactQueueFree	(ContactQueue *pQueue);
+void			ContactQueueClear	(ContactQueue *pQueue);
+bool			ContactQueueBegin	(ContactQueue *pQueue, unsigned int slotNum);
+unsigned int	ContactQueueEnd		(ContactQueue *pQueue);
+void			ContactQueueSortByTime(ContactQueue *pQueue);
+
+/**************************************************************************/
+/*!
+	Records that the pair tested in a slot touches
+	*/
+/**************************************************************************/
+inline void ContactQueueWrite(ContactQueue *pQueue, unsigned int slot, unsigned int a, unsigned int b,
+							  float timeOfImpact, const AEVec2 &normal)
+{
+	ContactEvent *pEvent = pQueue->pEvent + slot;
+
+	pEvent->a				= a;
+	pEvent->b				= b;
+	pEvent->type			= CONTACT_ENTER;
+	pEvent->timeOfImpact	= timeOfImpact;
+	pEvent->normal			= normal;
+	pEvent->slot			= slot;
+}
+
+
+#endif // CSD1130_CONTACT_QUEUE_H_
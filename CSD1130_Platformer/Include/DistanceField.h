@@ -0,0 +1,85 @@
+/******************************************************************************/
+/*!
+\file		DistanceField.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Distance to the nearest collision cell and free runs per direction,
+			built from the binary collision map.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_DISTANCE_FIELD_H_
+#define CSD1130_DISTANCE_FIELD_H_
+
+const unsigned int	DISTANCE_FIELD_MAX		= 255;	// distances and runs stop counting here, the value means "at least this far"
+
+enum RUN_DIRECTION
+{
+	RUN_LEFT = 0,
+	RUN_RIGHT,
+	RUN_DOWN,
+	RUN_UP,
+
+	RUN_DIRECTION_NUM
+};
+
+/**************************************************************************/
+/*!
+	One byte per cell for each table, rows stored one after the other from
+	y = 0 like the collision map.
+	pDistance is the chessboard distance in cells to the nearest collision
+	cell, 0 on a collision cell. A box no bigger than a cell, anywhere in a
+	cell at distance d, can move d - 1 cells in any direction without
+	entering a collision cell.
+	pRun is the number of free cells from a cell, itself included, to the
+	next collision cell or the map edge in each direction. 0 on a collision
+	cell.
+	*/
+/**************************************************************************/
+struct DistanceField
+{
+	int				width;
+	int				height;
+	unsigned char	*pDistance;
+	unsigned char	*pRun[RUN_DIRECTION_NUM];
+	unsigned int	distanceMax;		// no cell is further than this from a collision cell, bounds the cells a change can reach
+};
+
+bool	DistanceFieldInit	(DistanceField *pField, const CollisionMap &map);
+void	DistanceFieldFree	(DistanceField *pField);
+void	DistanceFieldUpdate	(DistanceField *pField, const CollisionMap &map, int X, int Y);
+
+/**************************************************************************/
+/*!
+	Distance of cell (X, Y) to the nearest collision cell, 0 outside of the
+	map where nothing is known
+	*/
+/**************************************************************************/
+inline unsigned int DistanceFieldGet(const DistanceField &field, int X, int Y)
+{
+	if ((unsigned int)X < (unsigned int)field.width && (unsigned int)Y < (unsigned int)field.height)
+		return field.pDistance[Y * field.width + X];
+
+	return 0;
+}
+
+/**************************************************************************/
+/*!
+	Free cells from cell (X, Y) in a direction, 0 outside of the map
+	*/
+/**************************************************************************/
+inline unsigned int DistanceFieldRun(const DistanceField &field, RUN_DIRECTION direction, int X, int Y)
+{
+	if ((unsigned int)X < (unsigned int)field.width && (unsigned int)Y < (unsigned int)field.height)
+		return field.pRun[direction][Y * field.width + X];
+
+	return 0;
+}
+
+
+#endif // CSD1130_DISTANCE_FIELD_H_
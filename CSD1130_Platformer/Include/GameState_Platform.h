@@ -25,6 +25,9 @@ void GameStatePlatformDraw(void);
 void GameStatePlatformFree(void);
 void GameStatePlatformUnload(void);
 
+void GameStatePlatformPreload(void);
+void GameStatePlatformPreloadFree(void);
+
 // ---------------------------------------------------------------------------
 
 #endif // CSD1130_GAME_STATE_PLAY_H_
\ No newline at end of file
@@ -0,0 +1,75 @@
+/******************************************************************************/
+/*!
+\file		LevelFile.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Binary level file that is mapped into memory and read in place.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_LEVEL_FILE_H_
+#define CSD1130_LEVEL_FILE_H_
+
+#define LEVEL_FILE_MAGIC	0x4C56454Cu		// "LEVL" in the first four bytes
+#define LEVEL_FILE_VERSION	1u
+
+/**************************************************************************/
+/*!
+	Start of a level file. The cells follow the header, one byte per cell
+	with the same values as the text format, in rows from y = 0 (the first
+	line of the text file). The spawn table follows the cells on a 4 byte
+	boundary. Offsets are in bytes from the start of the file.
+	*/
+/**************************************************************************/
+struct LevelFileHeader
+{
+	unsigned int	magic;
+	unsigned int	version;
+	unsigned int	width;
+	unsigned int	height;
+	unsigned int	cellOffset;
+	unsigned int	spawnOffset;
+	unsigned int	spawnNum;
+	unsigned int	reserved;		// 0, keeps the header 32 bytes long
+};
+
+/**************************************************************************/
+/*!
+	Object in a cell of the level, the table lists them in the order the
+	level creates them: by column, then by row
+	*/
+/**************************************************************************/
+struct LevelSpawn
+{
+	unsigned int	x;
+	unsigned int	y;
+	unsigned int	type;
+};
+
+/**************************************************************************/
+/*!
+	A level file mapped into memory, the pointers go into the mapping and
+	stay valid until the file is closed. The cells can be changed, the
+	changes are private to the mapping and are not written to the file.
+	*/
+/**************************************************************************/
+struct LevelFile
+{
+	const LevelFileHeader	*pHeader;		// 0 when no file is open
+	unsigned char			*pCells;
+	const LevelSpawn		*pSpawn;
+	size_t					size;			// bytes mapped
+};
+
+bool			LevelFileOpen	(LevelFile *pFile, const char *FileName);
+void			LevelFileClose	(LevelFile *pFile);
+bool			LevelFileWrite	(const char *FileName, const unsigned char *pCells, int width, int height);
+unsigned int	LevelFileSpawns	(const unsigned char *pCells, int width, int height, LevelSpawn *pSpawn);
+
+
+#endif // CSD1130_LEVEL_FILE_H_
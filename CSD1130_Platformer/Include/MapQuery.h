@@ -0,0 +1,51 @@
+/******************************************************************************/
+/*!
+\file		MapQuery.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Ray, box and ground queries against the collision map.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+/******************************************************************************/
+
+#ifndef CSD1130_MAP_QUERY_H_
+#define CSD1130_MAP_QUERY_H_
+
+/**************************************************************************/
+/*!
+	A ray from origin along dir, up to maxT times dir
+	*/
+/**************************************************************************/
+struct MapRay
+{
+	AEVec2	origin;
+	AEVec2	dir;
+	float	maxT;
+};
+
+/**************************************************************************/
+/*!
+	Where a ray stopped
+	*/
+/**************************************************************************/
+struct MapRayHit
+{
+	float	t;			// the ray reached origin + t * dir, maxT if it hit nothing
+	int		cellX;		// collision cell that was hit
+	int		cellY;
+	AEVec2	normal;		// side of the cell that was hit, zero if the ray starts inside it
+	bool	hit;
+};
+
+bool			MapQueryRaycast			(const CollisionMap &map, const MapRay &ray, MapRayHit *pHit);
+void			MapQueryRaycastBatch	(const CollisionMap &map, const MapRay *pRay, unsigned int num, MapRayHit *pHit);
+bool			MapQueryBoxOverlap		(const CollisionMap &map, const AABB &box);
+unsigned int	MapQueryBoxOverlapBatch	(const CollisionMap &map, const AABB *pBox, unsigned int num, unsigned int *pHitMask);
+int				MapQuerySolidBelow		(const CollisionMap &map, int X, int Y);
+
+
+#endif // CSD1130_MAP_QUERY_H_
@@ -0,0 +1,40 @@
+/******************************************************************************/
+/*!
+\file		MeshCache.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_MESH_CACHE_H_
+#define CSD1130_MESH_CACHE_H_
+
+/**************************************************************************/
+/*!
+	Shapes the mesh cache knows how to build
+	*/
+/**************************************************************************/
+enum MESH_SHAPE
+{
+	MESH_SHAPE_QUAD = 0,		// unit square centered on the origin
+	MESH_SHAPE_CIRCLE,			// unit diameter circle made of triangle fans
+};
+
+/**************************************************************************/
+/*!
+	Meshes are created the first time they are asked for and live until
+	MeshCacheFree is called, so game states can be unloaded and loaded
+	again without rebuilding them.
+	*/
+/**************************************************************************/
+AEGfxVertexList*	MeshCacheGet(MESH_SHAPE shape, u32 color, u32 parts = 0);
+void				MeshCacheFree(void);
+
+
+#endif // CSD1130_MESH_CACHE_H_
@@ -0,0 +1,369 @@
+/******************************************************************************/
+/*!
+\file		PlatformSim.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_PLATFORM_SIM_H_
+#define CSD1130_PLATFORM_SIM_H_
+
+// ---------------------------------------------------------------------------
+// includes
+
+// headless builds get the math part of the Alpha Engine without the window and graphics
+#ifdef PLATFORMER_HEADLESS
+#include "AEHeadless.h"
+#else
+#include "AEEngine.h"
+#endif
+
+#include "Collision.h"
+#include "Broadphase.h"
+#include "ContactQueue.h"
+#include "CollisionMap.h"
+#include "ColliderList.h"
+#include "DistanceField.h"
+#include "MapQuery.h"
+#include "LevelFile.h"
+#include "TileGrid.h"
+
+
+/******************************************************************************/
+/*!
+	Defines
+*/
+/******************************************************************************/
+const unsigned int	GAME_OBJ_NUM_MAX		= 32;	//The total number of different objects (Shapes)
+const unsigned int	GAME_OBJ_INST_CHUNK_SHIFT	= 10;
+const unsigned int	GAME_OBJ_INST_CHUNK_SIZE	= 1 << GAME_OBJ_INST_CHUNK_SHIFT;	//The number of instances per pool chunk, the pool grows one chunk at a time
+const unsigned int	GAME_OBJ_INST_CHUNK_MASK	= GAME_OBJ_INST_CHUNK_SIZE - 1;
+const unsigned int	PARTICLES_MAX			= 200;
+const unsigned int	LEVEL_PRELOAD_MAX		= 2;	//The number of levels that can be read in the background at once
+
+//Gameplay related variables and values
+const float			GRAVITY					= -20.0f;
+const float			JUMP_VELOCITY			= 11.0f;
+const float			MOVE_VELOCITY_HERO		= 4.0f;
+const float			MOVE_VELOCITY_ENEMY		= 7.5f;
+const double		ENEMY_IDLE_TIME			= 2.0;
+const int			HERO_LIVES				= 3;
+const float			BOUNDING_RECT_SIZE		= 1.0f;
+
+//Particle related variables and values
+const float			EMISSION_RATE			= 50.f;			// emission rate (particles per second)
+const float			VELOCITY_MAX			= 7.f;			// max velocity
+const float			VELOCITY_MIN			= 5.5f;			// min velocity
+const float			LIFESPAN_MAX			= 0.8f;			// max lifespan (seconds)
+const float			LIFESPAN_MIN			= 0.6f;			// min lifespan (seconds)
+const float			SCALE_MAX				= 0.5f;
+const float			SCALE_MIN				= 0.1f;
+const float			TRANSPARENCY_MAX		= 0.4f;
+const float			TRANSPARENCY_MIN		= 0.8f;
+
+//Flags
+const unsigned int	FLAG_ACTIVE				= 0x00000001;
+const unsigned int	FLAG_VISIBLE			= 0x00000002;
+const unsigned int	FLAG_NON_COLLIDABLE		= 0x00000004;
+
+//Object instance handles hold the handle slot in the low bits and its generation in the high bits
+const unsigned int	GAME_OBJ_INST_HANDLE_INDEX_BITS	= 24;
+const unsigned int	GAME_OBJ_INST_HANDLE_INDEX_MASK	= (1 << GAME_OBJ_INST_HANDLE_INDEX_BITS) - 1;
+const unsigned int	GAME_OBJ_INST_HANDLE_GEN_MASK	= 0xFF;
+
+//Returned by gameObjInstCreate when no instance slot could be allocated
+const unsigned int	GAME_OBJ_INST_NONE		= 0xFFFFFFFF;
+
+//Collision flags
+const unsigned int	COLLISION_LEFT			= 0x00000001;	//0001
+const unsigned int	COLLISION_RIGHT			= 0x00000002;	//0010
+const unsigned int	COLLISION_TOP			= 0x00000004;	//0100
+const unsigned int	COLLISION_BOTTOM		= 0x00000008;	//1000
+
+
+enum TYPE_OBJECT
+{
+	TYPE_OBJECT_EMPTY,			//0
+	TYPE_OBJECT_COLLISION,		//1
+	TYPE_OBJECT_HERO,			//2
+	TYPE_OBJECT_ENEMY1,			//3
+	TYPE_OBJECT_COIN,			//4
+	TYPE_OBJECT_PARTICLE,		//5
+
+	TYPE_OBJECT_NUM
+};
+
+//State machine states
+enum STATE
+{
+	STATE_NONE,
+	STATE_GOING_LEFT,
+	STATE_GOING_RIGHT
+};
+
+//State machine inner states
+enum INNER_STATE
+{
+	INNER_STATE_ON_ENTER,
+	INNER_STATE_ON_UPDATE,
+	INNER_STATE_ON_EXIT
+};
+
+enum DIRECTION 
+{
+	FACE_LEFT,
+	FACE_RIGHT
+};
+
+/******************************************************************************/
+/*!
+	Struct/Class Definitions
+*/
+/******************************************************************************/
+/*
+ * Input for one frame of the simulation
+ */
+struct PlatformSimInput
+{
+	bool			left;		// move left is held
+	bool			right;		// move right is held, wins over left
+	bool			jump;		// jump was pressed this frame
+};
+
+/*
+ * Code paths of the simulation that can be switched off to compare them
+ * with the path they replaced
+ */
+enum PLATFORM_SIM_OPTION
+{
+	PLATFORM_SIM_OPTION_FUSED_UPDATE,		// update instances in one fused pass instead of one pass per step
+	PLATFORM_SIM_OPTION_SLEEPING_COINS		// put coins to sleep when they spawn, takes effect at the next init
+};
+
+/*
+ * What happened to the level during a frame
+ */
+enum PLATFORM_SIM_RESULT
+{
+	PLATFORM_SIM_RESULT_NONE,		// keep playing
+	PLATFORM_SIM_RESULT_LOST,		// the hero ran out of lives
+	PLATFORM_SIM_RESULT_CLEARED		// every coin was collected
+};
+
+struct GameObj
+{
+	unsigned int		type;		// object type
+	AEGfxVertexList *	pMesh;		// pbject
+};
+
+struct Particle {
+	GameObj*		pObject;
+	f32				scale;
+	f32				lifespan;
+	f32				velCurr;
+	AEVec2			posCurr;
+	f32				transparency;
+	unsigned int	flag;
+	AEMtx33			transform;
+};
+
+/*
+ * Instance data that is not streamed by the per-frame passes.
+ * Flag, position, velocity, bounding box, transform and state machine data
+ * are kept in separate arrays, see the object instance accessors.
+ */
+struct GameObjInst
+{
+	GameObj *		pObject;			// pointer to the 'original'
+	float			scale;				// object scale
+	float			dirCurr;			// object current direction
+	enum			DIRECTION face;		// direction the object is facing (left/right)
+
+	//Collision Flags
+	int				gridCollisionFlag;
+	int				gridCollisionFlagPrev;
+
+	// pointer to custom data specific for each object type
+	void*			pUserData;
+};
+
+/*
+ * Dense, unordered list of the active instance slots of one object type
+ */
+struct GameObjInstBucket
+{
+	unsigned int	*pList;
+	unsigned int	num;
+	unsigned int	max;		// allocated length of pList
+};
+
+struct GameObjInstState
+{
+	//State of the object instance
+	enum			STATE state;
+	enum			INNER_STATE innerState;
+
+	//General purpose counter (This variable will be used for the enemy state machine)
+	double			counter;
+};
+
+/*
+ * Fixed-size block of instance slots, stored as one array per field.
+ * The pool grows by adding chunks, so an instance never moves once created.
+ */
+struct GameObjInstChunk
+{
+	GameObjInst			inst		[GAME_OBJ_INST_CHUNK_SIZE];
+	unsigned int		flag		[GAME_OBJ_INST_CHUNK_SIZE];	// bit flag or-ed together
+	AEVec2				posCurr		[GAME_OBJ_INST_CHUNK_SIZE];	// object current position
+	AEVec2				velCurr		[GAME_OBJ_INST_CHUNK_SIZE];	// object current velocity
+	AABB				boundingBox	[GAME_OBJ_INST_CHUNK_SIZE];	// object bouding box that encapsulates the object
+	AEMtx33				transform	[GAME_OBJ_INST_CHUNK_SIZE];	// object drawing matrix
+	GameObjInstState	state		[GAME_OBJ_INST_CHUNK_SIZE];	// state machine data
+	unsigned int		livePos		[GAME_OBJ_INST_CHUNK_SIZE];	// position in the live list
+	unsigned int		bucketPos	[GAME_OBJ_INST_CHUNK_SIZE];	// position in the bucket of its type
+	unsigned int		handle		[GAME_OBJ_INST_CHUNK_SIZE];	// handle slot that points at the instance
+	unsigned int		awakePos	[GAME_OBJ_INST_CHUNK_SIZE];	// position in the awake list, or GAME_OBJ_INST_NONE while asleep
+};
+
+/*
+ * Indirection from an object instance handle to the instance slot.
+ * The generation is bumped whenever the handle slot is released, so
+ * handles to destroyed instances can be told apart from live ones.
+ */
+struct GameObjInstHandleSlot
+{
+	unsigned int		inst;
+	unsigned int		generation;
+};
+
+typedef unsigned int	GameObjInstHandle;
+
+
+
+/******************************************************************************/
+/*!
+	Simulation globals
+*/
+/******************************************************************************/
+extern float				g_dt;
+
+// list of original objects
+extern GameObj				*gGameObjList;
+extern unsigned int			gGameObjNum;
+
+// object instance pool, slot i lives in chunk (i >> GAME_OBJ_INST_CHUNK_SHIFT)
+extern GameObjInstChunk		**gGameObjInstChunks;
+extern unsigned int			gGameObjInstNum;			// number of active instances
+
+// dense, unordered list of active instance slots (gGameObjInstNum long)
+extern unsigned int			*gGameObjInstLiveList;
+
+// handle slots, the table grows with the pool
+extern GameObjInstHandleSlot	*gGameObjInstHandleList;
+extern unsigned int			gGameObjInstHandleNum;
+
+// particle array (PARTICLES_MAX long)
+extern Particle				*gParticlesList;
+
+//Binary map data
+extern TileGrid				MapData;
+extern CollisionMap			BinaryCollisionMap;
+extern ColliderList			BinaryColliderList;
+extern DistanceField		BinaryDistanceField;
+extern int					BINARY_MAP_WIDTH;
+extern int					BINARY_MAP_HEIGHT;
+extern GameObjInstHandle	BlackInstance;
+extern GameObjInstHandle	WhiteInstance;
+
+extern GameObjInstHandle	HeroInstance;
+extern int					HeroLives;		// Number of hero lives
+extern int					TotalCoins;		// Total coins in level
+
+/*SIMULATION FUNCTIONS*/
+int							PlatformSimLoad(const char *FileName);
+void						PlatformSimPreload(const char *FileName);
+void						PlatformSimPreloadFree(void);
+void						PlatformSimInit(void);
+PLATFORM_SIM_RESULT			PlatformSimUpdate(const PlatformSimInput &input);
+void						PlatformSimFree(void);
+void						PlatformSimUnload(void);
+void						PlatformSimSetOption(PLATFORM_SIM_OPTION option, bool on);
+
+/*OBJECT INSTANCES*/
+GameObjInstHandle			gameObjInstCreate(unsigned int type,	float scale, 
+											  AEVec2* pPos,			AEVec2* pVel, 
+											  float dir,			enum STATE startState);
+void						gameObjInstDestroy(unsigned int inst);
+size_t						gameObjInstPoolMemory(void);
+
+/*INSTANCE SLEEP*/
+void						gameObjInstSleep(unsigned int inst);
+void						gameObjInstWake(unsigned int inst);
+
+/*MAP FUNCTIONS*/
+int							GetCellValue(int X, int Y);
+void						SetCellValue(int X, int Y, int value);
+int							CheckInstanceBinaryMapCollision(float PosX, float PosY, 
+															float scaleX, float scaleY);
+void						SnapToCell(float *Coordinate);
+int							ImportMapDataFromFile(const char *FileName);
+int							ExportMapDataToFile(const char *FileName);
+void						FreeMapData(void);
+
+
+/******************************************************************************/
+/*!
+	Object instance accessors, an instance is identified by its slot index
+*/
+/******************************************************************************/
+inline GameObjInstChunk*	gameObjInstChunk		(unsigned int inst) { return gGameObjInstChunks[inst >> GAME_OBJ_INST_CHUNK_SHIFT]; }
+
+inline GameObjInst*			gameObjInst				(unsigned int inst) { return gameObjInstChunk(inst)->inst			+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+inline unsigned int*		gameObjInstFlag			(unsigned int inst) { return gameObjInstChunk(inst)->flag			+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+inline AEVec2*				gameObjInstPos			(unsigned int inst) { return gameObjInstChunk(inst)->posCurr		+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+inline AEVec2*				gameObjInstVel			(unsigned int inst) { return gameObjInstChunk(inst)->velCurr		+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+inline AABB*				gameObjInstBoundingBox	(unsigned int inst) { return gameObjInstChunk(inst)->boundingBox	+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+inline AEMtx33*				gameObjInstTransform	(unsigned int inst) { return gameObjInstChunk(inst)->transform		+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+inline GameObjInstState*	gameObjInstState		(unsigned int inst) { return gameObjInstChunk(inst)->state			+ (inst & GAME_OBJ_INST_CHUNK_MASK); }
+
+/******************************************************************************/
+/*!
+	Returns the instance slot a handle points to.
+	Instance slots change when the pool is compacted, handles do not.
+*/
+/******************************************************************************/
+inline unsigned int gameObjInstResolve(GameObjInstHandle handle)
+{
+	GameObjInstHandleSlot *pSlot = gGameObjInstHandleList + (handle & GAME_OBJ_INST_HANDLE_INDEX_MASK);
+
+#if defined(DEBUG) | defined(_DEBUG)
+	AE_ASSERT_MESG((handle & GAME_OBJ_INST_HANDLE_INDEX_MASK) < gGameObjInstHandleNum &&
+				   pSlot->generation == handle >> GAME_OBJ_INST_HANDLE_INDEX_BITS,
+				   "stale object instance handle");
+#endif
+
+	return pSlot->inst;
+}
+
+/******************************************************************************/
+/*!
+	Returns the handle of an instance slot
+*/
+/******************************************************************************/
+inline GameObjInstHandle gameObjInstHandle(unsigned int inst)
+{
+	unsigned int handle = gameObjInstChunk(inst)->handle[inst & GAME_OBJ_INST_CHUNK_MASK];
+
+	return (gGameObjInstHandleList[handle].generation << GAME_OBJ_INST_HANDLE_INDEX_BITS) | handle;
+}
+
+
+#endif // CSD1130_PLATFORM_SIM_H_
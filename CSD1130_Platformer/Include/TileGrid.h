@@ -0,0 +1,55 @@
+/******************************************************************************/
+/*!
+\file		TileGrid.h
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Tile map stored as one byte per cell in a single block.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#ifndef CSD1130_TILE_GRID_H_
+#define CSD1130_TILE_GRID_H_
+
+/**************************************************************************/
+/*!
+	One TYPE_OBJECT value per cell, rows are stored one after the other
+	from y = 0, the same layout as the cells of a level file
+	*/
+/**************************************************************************/
+struct TileGrid
+{
+	unsigned char	*pCells;
+	int				width;
+	int				height;
+};
+
+bool	TileGridInit(TileGrid *pGrid, int width, int height);
+void	TileGridFree(TileGrid *pGrid);
+
+/**************************************************************************/
+/*!
+	Value of cell (X, Y), the cell must be inside of the grid
+	*/
+/**************************************************************************/
+inline int TileGridGet(const TileGrid &grid, int X, int Y)
+{
+	return grid.pCells[(size_t)Y * grid.width + X];
+}
+
+/**************************************************************************/
+/*!
+	Sets cell (X, Y), the cell must be inside of the grid
+	*/
+/**************************************************************************/
+inline void TileGridSet(TileGrid *pGrid, int X, int Y, int value)
+{
+	pGrid->pCells[(size_t)Y * pGrid->width + X] = (unsigned char)value;
+}
+
+
+#endif // CSD1130_TILE_GRID_H_
@@ -25,6 +25,7 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 #include "GameState_Platform.h"
 #include "Collision.h"
 #include "GameState_Menu.h"
+#include "MeshCache.h"
 
 //------------------------------------
 // Globals
@@ -0,0 +1,101 @@
+/******************************************************************************/
+/*!
+\file		AEHeadless.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "AEHeadless.h"
+
+/******************************************************************************/
+/*!
+	Vector functions used by the simulation
+*/
+/******************************************************************************/
+void AEVec2Zero(AEVec2* pResult)
+{
+	pResult->x = 0.0f;
+	pResult->y = 0.0f;
+}
+
+void AEVec2Set(AEVec2* pResult, f32 x, f32 y)
+{
+	pResult->x = x;
+	pResult->y = y;
+}
+
+void AEVec2Sub(AEVec2* pResult, AEVec2* pVec0, AEVec2* pVec1)
+{
+	pResult->x = pVec0->x - pVec1->x;
+	pResult->y = pVec0->y - pVec1->y;
+}
+
+/******************************************************************************/
+/*!
+	Matrix functions used by the simulation
+*/
+/******************************************************************************/
+void AEMtx33Identity(AEMtx33* pResult)
+{
+	memset(pResult, 0, sizeof(AEMtx33));
+	pResult->m[0][0] = pResult->m[1][1] = pResult->m[2][2] = 1.0f;
+}
+
+void AEMtx33Trans(AEMtx33* pResult, f32 x, f32 y)
+{
+	AEMtx33Identity(pResult);
+	pResult->m[0][2] = x;
+	pResult->m[1][2] = y;
+}
+
+void AEMtx33Scale(AEMtx33* pResult, f32 x, f32 y)
+{
+	AEMtx33Identity(pResult);
+	pResult->m[0][0] = x;
+	pResult->m[1][1] = y;
+}
+
+void AEMtx33Rot(AEMtx33* pResult, f32 angle)
+{
+	f32 c = cosf(angle), s = sinf(angle);
+
+	AEMtx33Identity(pResult);
+	pResult->m[0][0] = c;	pResult->m[0][1] = -s;
+	pResult->m[1][0] = s;	pResult->m[1][1] = c;
+}
+
+void AEMtx33Concat(AEMtx33* pResult, AEMtx33* pMtx0, AEMtx33* pMtx1)
+{
+	// pResult may be one of the operands
+	AEMtx33 result;
+
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			result.m[i][j] =	pMtx0->m[i][0] * pMtx1->m[0][j] +
+								pMtx0->m[i][1] * pMtx1->m[1][j] +
+								pMtx0->m[i][2] * pMtx1->m[2][j];
+
+	*pResult = result;
+}
+
+/******************************************************************************/
+/*!
+	Scalar functions used by the simulation
+*/
+/******************************************************************************/
+f32 AEMin(f32 x, f32 y)
+{
+	return x < y ? x : y;
+}
+
+f32 AEMax(f32 x, f32 y)
+{
+	return x > y ? x : y;
+}
@@ -0,0 +1,414 @@
+/******************************************************************************/
+/*!
+\file		Broadphase.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Uniform grid broadphase for rect-rect collision.
+
+			Boxes are added every frame, then counted and sorted into the
+			cells they cover. Each cell pairs up its own boxes, and a pair
+			is only kept by the first cell both boxes cover, so a pair that
+			shares several cells is reported once.
+			The cost grows with the number of boxes and the cells they
+			cover, not with the size of the grid.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+
+/******************************************************************************/
+/*!
+	Defines
+*/
+/******************************************************************************/
+const unsigned int	BROADPHASE_GROW_MIN		= 256;			// first capacity of the item, cell and pair lists
+const unsigned int	BROADPHASE_CELL_NONE	= 0xFFFFFFFF;	// key of an unused hash slot
+
+/******************************************************************************/
+/*!
+	Sets up a width by height grid. Nothing is allocated per cell, the
+	grid only has to be small enough for every cell to have a 32-bit
+	index.
+*/
+/******************************************************************************/
+bool BroadphaseInit(Broadphase *pBroadphase, float cellSize, int width, int height)
+{
+	memset(pBroadphase, 0, sizeof(Broadphase));
+
+	// width * height < BROADPHASE_CELL_NONE, without computing the product
+	if (width <= 0 || height <= 0 ||
+		(size_t)width > (size_t)(BROADPHASE_CELL_NONE - 1) / (size_t)height)
+		return false;
+
+	pBroadphase->cellSize	= cellSize;
+	pBroadphase->width		= width;
+	pBroadphase->height		= height;
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Frees the grid
+*/
+/******************************************************************************/
+void BroadphaseFree(Broadphase *pBroadphase)
+{
+	free(pBroadphase->pCellKey);
+	free(pBroadphase->pCellStart);
+	free(pBroadphase->pCellList);
+	free(pBroadphase->pCellItem);
+	free(pBroadphase->pEntrySlot);
+	free(pBroadphase->pItemId);
+	free(pBroadphase->pItemBox);
+	free(pBroadphase->pItemRange);
+	free(pBroadphase->pPair);
+
+	memset(pBroadphase, 0, sizeof(Broadphase));
+}
+
+/******************************************************************************/
+/*!
+	Removes every box, the memory is kept for the next frame
+*/
+/******************************************************************************/
+void BroadphaseClear(Broadphase *pBroadphase)
+{
+	pBroadphase->itemNum = 0;
+	pBroadphase->pairNum = 0;
+}
+
+/******************************************************************************/
+/*!
+	Cell of a coordinate, clamped to the grid
+*/
+/******************************************************************************/
+static int broadphaseCell(float coordinate, float cellSize, int num)
+{
+	// truncation only differs from floor below 0, which is clamped anyway
+	int cell = (int)(coordinate / cellSize);
+
+	if (cell < 0)
+		return 0;
+
+	if (cell >= num)
+		return num - 1;
+
+	return cell;
+}
+
+/******************************************************************************/
+/*!
+	Doubles the length of the item lists
+*/
+/******************************************************************************/
+static bool broadphaseItemGrow(Broadphase *pBroadphase)
+{
+	unsigned int max = pBroadphase->itemMax ? pBroadphase->itemMax * 2 : BROADPHASE_GROW_MIN;
+
+	unsigned int *pId = (unsigned int*)realloc(pBroadphase->pItemId, max * sizeof(unsigned int));
+	if (0 == pId)
+		return false;
+	pBroadphase->pItemId = pId;
+
+	AABB *pBox = (AABB*)realloc(pBroadphase->pItemBox, max * sizeof(AABB));
+	if (0 == pBox)
+		return false;
+	pBroadphase->pItemBox = pBox;
+
+	BroadphaseCellRange *pRange = (BroadphaseCellRange*)realloc(pBroadphase->pItemRange, max * sizeof(BroadphaseCellRange));
+	if (0 == pRange)
+		return false;
+	pBroadphase->pItemRange = pRange;
+
+	pBroadphase->itemMax = max;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Grows a list of unsigned ints to hold at least num entries
+*/
+/******************************************************************************/
+static bool broadphaseListReserve(unsigned int **ppList, unsigned int *pMax, unsigned int num)
+{
+	if (num <= *pMax)
+		return true;
+
+	unsigned int max = *pMax ? *pMax : BROADPHASE_GROW_MIN;
+	while (max < num)
+		max *= 2;
+
+	unsigned int *pList = (unsigned int*)realloc(*ppList, max * sizeof(unsigned int));
+	if (0 == pList)
+		return false;
+
+	*ppList	= pList;
+	*pMax	= max;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Makes the cell hash table at least twice as long as the entries, so
+	that probe runs stay short. When the grid has fewer cells than that,
+	the table gets one slot per cell instead. A new table starts with
+	every slot unused.
+*/
+/******************************************************************************/
+static bool broadphaseHashReserve(Broadphase *pBroadphase, unsigned int entryNum)
+{
+	unsigned int max		= BROADPHASE_GROW_MIN;
+	unsigned int gridNum	= (unsigned int)pBroadphase->width * (unsigned int)pBroadphase->height;
+
+	while (max / 2 < entryNum && max < gridNum && max <= 0x7FFFFFFF)
+		max *= 2;
+
+	bool direct = gridNum <= max;
+
+	if (!direct && max / 2 < entryNum)
+		return false;
+
+	if (direct)
+		max = gridNum;
+
+	if (direct == pBroadphase->cellDirect && max <= pBroadphase->cellHashMax)
+		return true;
+
+	unsigned int *pKey = (unsigned int*)realloc(pBroadphase->pCellKey, max * sizeof(unsigned int));
+	if (0 == pKey)
+		return false;
+	pBroadphase->pCellKey = pKey;
+
+	unsigned int *pStart = (unsigned int*)realloc(pBroadphase->pCellStart, max * sizeof(unsigned int));
+	if (0 == pStart)
+		return false;
+	pBroadphase->pCellStart = pStart;
+
+	memset(pKey,	0xFF,	max * sizeof(unsigned int));
+	memset(pStart,	0,		max * sizeof(unsigned int));
+
+	pBroadphase->cellHashMax	= max;
+	pBroadphase->cellDirect		= direct;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Hash slot of a cell, the cell is given the first unused slot of its
+	probe run if it has none yet
+*/
+/******************************************************************************/
+static unsigned int broadphaseHashSlot(const Broadphase *pBroadphase, unsigned int cell)
+{
+	if (pBroadphase->cellDirect)
+		return cell;
+
+	unsigned int mask = pBroadphase->cellHashMax - 1;
+	unsigned int slot = (cell * 2654435761u) & mask;
+
+	while (pBroadphase->pCellKey[slot] != cell && pBroadphase->pCellKey[slot] != BROADPHASE_CELL_NONE)
+		slot = (slot + 1) & mask;
+
+	return slot;
+}
+
+/******************************************************************************/
+/*!
+	Doubles the length of the pair list
+*/
+/******************************************************************************/
+static bool broadphasePairGrow(Broadphase *pBroadphase)
+{
+	unsigned int max = pBroadphase->pairMax ? pBroadphase->pairMax * 2 : BROADPHASE_GROW_MIN;
+
+	BroadphasePair *pPair = (BroadphasePair*)realloc(pBroadphase->pPair, max * sizeof(BroadphasePair));
+	if (0 == pPair)
+		return false;
+	pBroadphase->pPair = pPair;
+
+	pBroadphase->pairMax = max;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Adds a box for this frame, id is reported back in the pairs.
+	Returns false if the box could not be stored.
+*/
+/******************************************************************************/
+bool BroadphaseAdd(Broadphase *pBroadphase, unsigned int id, const AABB &box)
+{
+	if (pBroadphase->itemNum == pBroadphase->itemMax && !broadphaseItemGrow(pBroadphase))
+		return false;
+
+	unsigned int		item	= pBroadphase->itemNum++;
+	BroadphaseCellRange	*pRange	= pBroadphase->pItemRange + item;
+
+	pBroadphase->pItemId[item]	= id;
+	pBroadphase->pItemBox[item]	= box;
+
+	pRange->x0 = broadphaseCell(box.min.x, pBroadphase->cellSize, pBroadphase->width);
+	pRange->y0 = broadphaseCell(box.min.y, pBroadphase->cellSize, pBroadphase->height);
+	pRange->x1 = broadphaseCell(box.max.x, pBroadphase->cellSize, pBroadphase->width);
+	pRange->y1 = broadphaseCell(box.max.y, pBroadphase->cellSize, pBroadphase->height);
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Reports the overlapping items of one cell, returns false if the pair
+	list could not grow
+*/
+/******************************************************************************/
+static bool broadphaseCellPairs(Broadphase *pBroadphase, unsigned int cell, unsigned int start, unsigned int end)
+{
+	int					x		= cell % pBroadphase->width;
+	int					y		= cell / pBroadphase->width;
+	unsigned int		*pItem	= pBroadphase->pCellItem;
+	BroadphaseCellRange	*pRange	= pBroadphase->pItemRange;
+	AABB				*pBox	= pBroadphase->pItemBox;
+
+	for (unsigned int i = start; i + 1 < end; ++i)
+	{
+		unsigned int a = pItem[i];
+
+		for (unsigned int j = i + 1; j < end; ++j)
+		{
+			unsigned int b = pItem[j];
+
+			// only the first cell both items cover reports the pair
+			if (x != (pRange[a].x0 > pRange[b].x0 ? pRange[a].x0 : pRange[b].x0) ||
+				y != (pRange[a].y0 > pRange[b].y0 ? pRange[a].y0 : pRange[b].y0))
+				continue;
+
+			if (pBox[a].min.x > pBox[b].max.x ||
+				pBox[a].max.x < pBox[b].min.x ||
+				pBox[a].min.y > pBox[b].max.y ||
+				pBox[a].max.y < pBox[b].min.y)
+				continue;
+
+			if (pBroadphase->pairNum == pBroadphase->pairMax && !broadphasePairGrow(pBroadphase))
+				return false;
+
+			BroadphasePair *pPair = pBroadphase->pPair + pBroadphase->pairNum++;
+
+			pPair->a = pBroadphase->pItemId[a];
+			pPair->b = pBroadphase->pItemId[b];
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Finds every pair of added boxes that overlap, using the same overlap
+	test as CollisionIntersection_RectRect. The pairs are left in pPair
+	and their number is returned.
+	Pairs that do not fit once the pair list cannot grow are dropped.
+*/
+/******************************************************************************/
+unsigned int BroadphaseFindPairs(Broadphase *pBroadphase)
+{
+	int					x, y;
+	unsigned int		i, k;
+	unsigned int		cellNum		= 0;
+	unsigned int		entryNum	= 0;
+	unsigned int		*pStart;
+	unsigned int		*pKey;
+	unsigned int		*pCellList;
+	unsigned int		*pEntrySlot;
+	BroadphaseCellRange	*pRange		= pBroadphase->pItemRange;
+
+	pBroadphase->pairNum = 0;
+
+	// each item adds one entry per cell it covers
+	for (i = 0; i < pBroadphase->itemNum; ++i)
+		entryNum += (pRange[i].x1 - pRange[i].x0 + 1) * (pRange[i].y1 - pRange[i].y0 + 1);
+
+	if (!broadphaseListReserve(&pBroadphase->pCellList, &pBroadphase->cellListMax, entryNum) ||
+		!broadphaseListReserve(&pBroadphase->pCellItem, &pBroadphase->cellItemMax, entryNum) ||
+		!broadphaseHashReserve(pBroadphase, entryNum) ||
+		(!pBroadphase->cellDirect && !broadphaseListReserve(&pBroadphase->pEntrySlot, &pBroadphase->entrySlotMax, entryNum)))
+		return 0;
+
+	pCellList	= pBroadphase->pCellList;
+	pStart		= pBroadphase->pCellStart;
+	pKey		= pBroadphase->pCellKey;
+	pEntrySlot	= pBroadphase->pEntrySlot;
+
+	/*COUNT THE ITEMS OF EACH CELL*/
+	// hashed slots are kept so that the sort does not look the cells up again
+	for (i = 0, k = 0; i < pBroadphase->itemNum; ++i)
+		for (y = pRange[i].y0; y <= pRange[i].y1; ++y)
+			for (x = pRange[i].x0; x <= pRange[i].x1; ++x)
+			{
+				unsigned int cell = (unsigned int)y * pBroadphase->width + x;
+				unsigned int slot = broadphaseHashSlot(pBroadphase, cell);
+
+				if (0 == pStart[slot]++)
+				{
+					pKey[slot]				= cell;
+					pCellList[cellNum++]	= slot;
+				}
+
+				if (!pBroadphase->cellDirect)
+					pEntrySlot[k++] = slot;
+			}
+
+	// running total over the listed cells, each cell now holds the end of its items
+	for (k = 0, entryNum = 0; k < cellNum; ++k)
+	{
+		entryNum				+= pStart[pCellList[k]];
+		pStart[pCellList[k]]	= entryNum;
+	}
+
+	/*SORT THE ITEMS INTO THEIR CELLS*/
+	// filling backwards moves each end back to the start and keeps the items in the order they were added
+	if (pBroadphase->cellDirect)
+	{
+		for (i = pBroadphase->itemNum; i > 0; --i)
+			for (y = pRange[i - 1].y0; y <= pRange[i - 1].y1; ++y)
+				for (x = pRange[i - 1].x0; x <= pRange[i - 1].x1; ++x)
+					pBroadphase->pCellItem[--pStart[y * pBroadphase->width + x]] = i - 1;
+	}
+	else
+	{
+		// the entries of an item are consecutive, walk them back item by item
+		for (i = pBroadphase->itemNum, k = entryNum; i > 0; --i)
+		{
+			unsigned int end = k;
+
+			k -= (pRange[i - 1].x1 - pRange[i - 1].x0 + 1) * (pRange[i - 1].y1 - pRange[i - 1].y0 + 1);
+
+			for (unsigned int e = k; e < end; ++e)
+				pBroadphase->pCellItem[--pStart[pEntrySlot[e]]] = i - 1;
+		}
+	}
+
+	/*PAIR THE ITEMS OF EACH CELL*/
+	// the listed cells hold consecutive ranges of items, a cell ends where the next one starts
+	for (k = 0; k < cellNum; ++k)
+	{
+		unsigned int end = k + 1 < cellNum ? pStart[pCellList[k + 1]] : entryNum;
+
+		if (!broadphaseCellPairs(pBroadphase, pKey[pCellList[k]], pStart[pCellList[k]], end))
+			break;
+	}
+
+	// leave every slot unused for the next frame
+	for (k = 0; k < cellNum; ++k)
+	{
+		pStart[pCellList[k]]	= 0;
+		pKey[pCellList[k]]		= BROADPHASE_CELL_NONE;
+	}
+
+	return pBroadphase->pairNum;
+}
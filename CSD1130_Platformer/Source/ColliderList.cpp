@@ -0,0 +1,347 @@
+/******************************************************************************/
+/*!
+\file		ColliderList.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Collision cells of the map merged into a few static rectangles.
+
+			The merge is greedy: from the lowest row up and left to right,
+			the first collision cell not yet covered starts a rectangle that
+			grows right as far as the row allows, then up for as long as the
+			whole next row under it is free to take, at most
+			COLLIDER_LIST_HEIGHT_MAX rows. It is not always the fewest
+			rectangles, but floors come out as one and walls as one per
+			COLLIDER_LIST_HEIGHT_MAX rows.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+
+/******************************************************************************/
+/*!
+	Defines
+*/
+/******************************************************************************/
+const unsigned int	COLLIDER_LIST_GROW_MIN	= 64;	// first capacity of the rectangle list
+
+/******************************************************************************/
+/*!
+	Doubles the length of the rectangle list
+*/
+/******************************************************************************/
+static bool colliderListGrow(ColliderList *pList)
+{
+	unsigned int max = pList->max ? pList->max * 2 : COLLIDER_LIST_GROW_MIN;
+
+	AABB *pRect = (AABB*)realloc(pList->pRect, max * sizeof(AABB));
+	if (0 == pRect)
+		return false;
+
+	pList->pRect	= pRect;
+	pList->max		= max;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Merges the collision cells of the map into rectangles, the memory of
+	an earlier build is reused
+*/
+/******************************************************************************/
+bool ColliderListBuild(ColliderList *pList, const CollisionMap &map)
+{
+	CollisionMap	left;		// collision cells not covered yet
+	int				x, y, x1, y1;
+
+	pList->num		= 0;
+	pList->cellNum	= 0;
+
+	if (!CollisionMapInit(&left, map.width, map.height))
+		return false;
+
+	memcpy(left.pWords, map.pWords, map.rowWords * map.height * sizeof(unsigned int));
+
+	for (y = 0; y < map.height; ++y)
+		for (x = 0; x < map.width; ++x)
+		{
+			if (!CollisionMapGet(left, x, y))
+				continue;
+
+			// as far right as the row goes
+			for (x1 = x + 1; CollisionMapGet(left, x1, y); ++x1)
+				;
+
+			// as far up as whole rows go, a tall wall is cut into several rectangles
+			for (y1 = y + 1; y1 < map.height && y1 < y + COLLIDER_LIST_HEIGHT_MAX; ++y1)
+			{
+				int i;
+				for (i = x; i < x1 && CollisionMapGet(left, i, y1); ++i)
+					;
+				if (i < x1)
+					break;
+			}
+
+			if (pList->num == pList->max && !colliderListGrow(pList))
+			{
+				CollisionMapFree(&left);
+				return false;
+			}
+
+			AABB *pRect = pList->pRect + pList->num++;
+			AEVec2Set(&pRect->min, (float)x,	(float)y	);
+			AEVec2Set(&pRect->max, (float)x1,	(float)y1	);
+
+			for (int j = y; j < y1; ++j)
+				for (int i = x; i < x1; ++i)
+					CollisionMapSet(&left, i, j, 0);
+
+			pList->cellNum += (x1 - x) * (y1 - y);
+		}
+
+	CollisionMapFree(&left);
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Inserts a rectangle where its min.y keeps the list sorted
+*/
+/******************************************************************************/
+static bool colliderListInsert(ColliderList *pList, int x0, int y0, int x1, int y1)
+{
+	if (x0 >= x1 || y0 >= y1)
+		return true;
+
+	if (pList->num == pList->max && !colliderListGrow(pList))
+		return false;
+
+	// after the rectangles that start on the same row or below it
+	unsigned int first = 0, last = pList->num;
+
+	while (first < last)
+	{
+		unsigned int middle = (first + last) / 2;
+
+		if (pList->pRect[middle].min.y <= (float)y0)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	AABB *pRect = pList->pRect + first;
+
+	memmove(pRect + 1, pRect, (pList->num - first) * sizeof(AABB));
+	AEVec2Set(&pRect->min, (float)x0, (float)y0);
+	AEVec2Set(&pRect->max, (float)x1, (float)y1);
+
+	++pList->num;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Changes one cell without merging the whole map again. A cell that
+	stops being a collision cell splits its rectangle into the rows below
+	it, the cells left and right of it and the rows above it. A new
+	collision cell joins a one row rectangle that ends next to it, or
+	becomes a rectangle of its own. The rectangles still cover every
+	collision cell exactly once, but can be more than a new build would
+	make. Returns false if the list could not grow, the list then has to
+	be built again.
+*/
+/******************************************************************************/
+bool ColliderListSetCell(ColliderList *pList, int X, int Y, bool collision)
+{
+	float			x		= (float)X, y = (float)Y;
+	unsigned int	first	= ColliderListFirst(*pList, y);
+	unsigned int	i;
+
+	// rectangles are sorted by min.y, none after the first one above the cell can hold it
+	for (i = first; i < pList->num && pList->pRect[i].min.y <= y; ++i)
+	{
+		AABB *pRect = pList->pRect + i;
+
+		if (pRect->min.x <= x && x < pRect->max.x && y < pRect->max.y)
+			break;
+	}
+
+	bool covered = i < pList->num && pList->pRect[i].min.y <= y;
+
+	if (covered == collision)
+		return true;
+
+	if (collision)
+	{
+		/*JOIN A ONE ROW RECTANGLE*/
+		for (i = first; i < pList->num && pList->pRect[i].min.y <= y; ++i)
+		{
+			AABB *pRect = pList->pRect + i;
+
+			if (pRect->min.y != y || pRect->max.y != y + 1.f)
+				continue;
+
+			if (pRect->max.x == x || pRect->min.x == x + 1.f)
+			{
+				pRect->min.x = AEMin(pRect->min.x, x);
+				pRect->max.x = AEMax(pRect->max.x, x + 1.f);
+
+				++pList->cellNum;
+				return true;
+			}
+		}
+
+		if (!colliderListInsert(pList, X, Y, X + 1, Y + 1))
+			return false;
+
+		++pList->cellNum;
+		return true;
+	}
+
+	/*SPLIT THE RECTANGLE*/
+	AABB rect = pList->pRect[i];
+
+	memmove(pList->pRect + i, pList->pRect + i + 1, (pList->num - i - 1) * sizeof(AABB));
+	--pList->num;
+	--pList->cellNum;
+
+	int x0 = (int)rect.min.x, y0 = (int)rect.min.y;
+	int x1 = (int)rect.max.x, y1 = (int)rect.max.y;
+
+	// the list only grows by the pieces after the first, which takes the place freed above
+	return	colliderListInsert(pList, x0,		y0,		x1,		Y		) &&
+			colliderListInsert(pList, x0,		Y,		X,		Y + 1	) &&
+			colliderListInsert(pList, X + 1,	Y,		x1,		Y + 1	) &&
+			colliderListInsert(pList, x0,		Y + 1,	x1,		y1		);
+}
+
+/******************************************************************************/
+/*!
+	Frees the rectangles
+*/
+/******************************************************************************/
+void ColliderListFree(ColliderList *pList)
+{
+	free(pList->pRect);
+
+	memset(pList, 0, sizeof(ColliderList));
+}
+
+/******************************************************************************/
+/*!
+	First rectangle that can reach above y, every rectangle before it ends
+	at or below y. Found by binary search on min.y, a rectangle is never
+	more than COLLIDER_LIST_HEIGHT_MAX rows tall.
+*/
+/******************************************************************************/
+unsigned int ColliderListFirst(const ColliderList &list, float y)
+{
+	float			bottom	= y - (float)COLLIDER_LIST_HEIGHT_MAX;
+	unsigned int	first	= 0, last = list.num;
+
+	while (first < last)
+	{
+		unsigned int middle = (first + last) / 2;
+
+		if (list.pRect[middle].min.y <= bottom)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	return first;
+}
+
+/******************************************************************************/
+/*!
+	Returns true if the box overlaps a rectangle, touching edges do not
+	count
+*/
+/******************************************************************************/
+bool ColliderListOverlap(const ColliderList &list, const AABB &box)
+{
+	for (unsigned int i = ColliderListFirst(list, box.min.y); i < list.num && list.pRect[i].min.y < box.max.y; ++i)
+	{
+		const AABB *pRect = list.pRect + i;
+
+		if (box.min.x < pRect->max.x && box.max.x > pRect->min.x &&
+			box.min.y < pRect->max.y && box.max.y > pRect->min.y)
+			return true;
+	}
+
+	return false;
+}
+
+/******************************************************************************/
+/*!
+	Moves a box by delta against the rectangles, the same way as
+	CollisionMapSweep moves it against the cells. Returns the fraction of
+	delta it can move before it enters a rectangle, 1 if it enters none.
+	Rectangles the box already overlaps are ignored.
+	pNormal is set to the side of the rectangle that was hit, or to zero.
+*/
+/******************************************************************************/
+float ColliderListSweep(const ColliderList &list, const AABB &box, const AEVec2 &delta, AEVec2 *pNormal)
+{
+	float toi		= 1.f;
+	float top		= AEMax(box.max.y, box.max.y + delta.y);
+	float bottom	= AEMin(box.min.y, box.min.y + delta.y);
+
+	AEVec2Zero(pNormal);
+
+	for (unsigned int i = ColliderListFirst(list, bottom); i < list.num && list.pRect[i].min.y < top; ++i)
+	{
+		const AABB	*pRect = list.pRect + i;
+		float		enterX, exitX, enterY, exitY;
+
+		/*X-AXIS*/
+		if (delta.x > 0.f) {
+			enterX	= (pRect->min.x - box.max.x) / delta.x;
+			exitX	= (pRect->max.x - box.min.x) / delta.x;
+		}
+		else if (delta.x < 0.f) {
+			enterX	= (pRect->max.x - box.min.x) / delta.x;
+			exitX	= (pRect->min.x - box.max.x) / delta.x;
+		}
+		else if (box.min.x < pRect->max.x && box.max.x > pRect->min.x) {
+			enterX	= -2.f;
+			exitX	= 2.f;
+		}
+		else continue;
+
+		/*Y-AXIS*/
+		if (delta.y > 0.f) {
+			enterY	= (pRect->min.y - box.max.y) / delta.y;
+			exitY	= (pRect->max.y - box.min.y) / delta.y;
+		}
+		else if (delta.y < 0.f) {
+			enterY	= (pRect->max.y - box.min.y) / delta.y;
+			exitY	= (pRect->min.y - box.max.y) / delta.y;
+		}
+		else if (box.min.y < pRect->max.y && box.max.y > pRect->min.y) {
+			enterY	= -2.f;
+			exitY	= 2.f;
+		}
+		else continue;
+
+		float enter	= AEMax(enterX, enterY);
+		float exit	= AEMin(exitX, exitY);
+
+		// the box enters while both axes overlap, and not earlier than a hit found before
+		if (enter < 0.f || enter >= exit || enter >= toi)
+			continue;
+
+		toi = enter;
+
+		if (enterX >= enterY)
+			AEVec2Set(pNormal, delta.x > 0.f ? -1.f : 1.f, 0.f);
+		else
+			AEVec2Set(pNormal, 0.f, delta.y > 0.f ? -1.f : 1.f);
+	}
+
+	return toi;
+}
@@ -12,7 +12,13 @@ prior written consent of DigiPen Institute of Technology is prohibited.
  */
  /******************************************************************************/
 
-#include "main.h"
+#include "PlatformSim.h"
+#include <algorithm>
+
+#if defined(_M_X64) | defined(_M_IX86) | defined(__SSE2__)
+#include <immintrin.h>
+#define COLLISION_SSE
+#endif
 
 /**************************************************************************/
 /*!
@@ -42,10 +48,10 @@ bool CollisionIntersection_RectRect(const AABB& aabb1, const AEVec2& vel1,
 
 		/*Get first and last collision time*/
 		if (aabb1.max.x < aabb2.min.x)
-			tFirst = max(((aabb1.max.x - aabb2.min.x) / vb.x), tFirst);
+			tFirst = AEMax(((aabb1.max.x - aabb2.min.x) / vb.x), tFirst);
 
 		if (aabb1.min.x < aabb2.max.x)
-			tLast = min(((aabb1.min.x - aabb2.max.x) / vb.x), tLast);
+			tLast = AEMin(((aabb1.min.x - aabb2.max.x) / vb.x), tLast);
 	}
 
 	if (vb.x > 0) {
@@ -53,10 +59,10 @@ bool CollisionIntersection_RectRect(const AABB& aabb1, const AEVec2& vel1,
 
 		/*Get first and last collision time*/
 		if (aabb1.min.x > aabb2.max.x)
-			tFirst = max(((aabb1.min.x - aabb2.max.x) / vb.x), tFirst);
+			tFirst = AEMax(((aabb1.min.x - aabb2.max.x) / vb.x), tFirst);
 
 		if (aabb1.max.x > aabb2.min.x)
-			tLast = min(((aabb1.max.x - aabb2.min.x) / vb.x), tLast);
+			tLast = AEMin(((aabb1.max.x - aabb2.min.x) / vb.x), tLast);
 	}
 
 	// if no velocity and objects do not intersect, return false
@@ -70,10 +76,10 @@ bool CollisionIntersection_RectRect(const AABB& aabb1, const AEVec2& vel1,
 
 		/*Get first and last collision time*/
 		if (aabb1.max.y < aabb2.min.y)
-			tFirst = max(((aabb1.max.y - aabb2.min.y) / vb.y), tFirst);
+			tFirst = AEMax(((aabb1.max.y - aabb2.min.y) / vb.y), tFirst);
 
 		if (aabb1.min.y < aabb2.max.y)
-			tLast = min(((aabb1.min.y - aabb2.max.y) / vb.y), tLast);
+			tLast = AEMin(((aabb1.min.y - aabb2.max.y) / vb.y), tLast);
 	}
 
 	if (vb.y > 0) {
@@ -81,10 +87,10 @@ bool CollisionIntersection_RectRect(const AABB& aabb1, const AEVec2& vel1,
 
 		/*Get first and last collision time*/
 		if (aabb1.min.y > aabb2.max.y)
-			tFirst = max(((aabb1.min.y - aabb2.max.y) / vb.y), tFirst);
+			tFirst = AEMax(((aabb1.min.y - aabb2.max.y) / vb.y), tFirst);
 
 		if (aabb1.max.y > aabb2.min.y)
-			tLast = min(((aabb1.max.y - aabb2.min.y) / vb.y), tLast);
+			tLast = AEMin(((aabb1.max.y - aabb2.min.y) / vb.y), tLast);
 	}
 
 	// if no velocity and objects do not intersect, return false
@@ -95,4 +101,321 @@ bool CollisionIntersection_RectRect(const AABB& aabb1, const AEVec2& vel1,
 	if (tFirst > tLast) return false;
 
 	else return true;
-}
\ No newline at end of file
+}
+
+/**************************************************************************/
+/*!
+	Swept test of two rectangles over the frame, from where they are now.
+	Unlike CollisionIntersection_RectRect, boxes that are apart can still
+	hit later in the frame. On a hit the contact gets the first and last
+	time they touch and the axis they meet along, pointing from box 1 to
+	box 2. Boxes that already overlap meet at 0 along the axis they
+	overlap least on.
+*/
+/**************************************************************************/
+bool CollisionIntersection_RectRectSwept(const AABB &aabb1, const AEVec2 &vel1,
+										 const AABB &aabb2, const AEVec2 &vel2,
+										 RectRectContact *pContact)
+{
+	AEVec2 vb, a = vel1, b = vel2, normal;
+	AEVec2Sub	(&vb, &b, &a);
+	AEVec2Zero	(&normal);
+
+	float tFirst = 0, tLast = g_dt, t;
+
+	/*X-AXIS*/
+	if (vb.x < 0) {
+		if (aabb1.min.x > aabb2.max.x) return false; // Moving away from each other
+
+		/*Get first and last collision time, box 2 comes from the right*/
+		if (aabb1.max.x < aabb2.min.x && (t = (aabb1.max.x - aabb2.min.x) / vb.x) > tFirst) {
+			tFirst = t;
+			AEVec2Set(&normal, 1.f, 0.f);
+		}
+
+		if (aabb1.min.x < aabb2.max.x)
+			tLast = AEMin(((aabb1.min.x - aabb2.max.x) / vb.x), tLast);
+	}
+
+	if (vb.x > 0) {
+		if (aabb1.max.x < aabb2.min.x) return false; // Moving away from each other
+
+		/*Get first and last collision time, box 2 comes from the left*/
+		if (aabb1.min.x > aabb2.max.x && (t = (aabb1.min.x - aabb2.max.x) / vb.x) > tFirst) {
+			tFirst = t;
+			AEVec2Set(&normal, -1.f, 0.f);
+		}
+
+		if (aabb1.max.x > aabb2.min.x)
+			tLast = AEMin(((aabb1.max.x - aabb2.min.x) / vb.x), tLast);
+	}
+
+	if (vb.x == 0) {
+		if (aabb1.max.x < aabb2.min.x || aabb2.max.x < aabb1.min.x) return false;
+	}
+
+	/*Y-AXIS*/
+	if (vb.y < 0) {
+		if (aabb1.min.y > aabb2.max.y) return false; // Moving away from each other
+
+		/*Get first and last collision time, box 2 comes from above*/
+		if (aabb1.max.y < aabb2.min.y && (t = (aabb1.max.y - aabb2.min.y) / vb.y) > tFirst) {
+			tFirst = t;
+			AEVec2Set(&normal, 0.f, 1.f);
+		}
+
+		if (aabb1.min.y < aabb2.max.y)
+			tLast = AEMin(((aabb1.min.y - aabb2.max.y) / vb.y), tLast);
+	}
+
+	if (vb.y > 0) {
+		if (aabb1.max.y < aabb2.min.y) return false; // Moving away from each other
+
+		/*Get first and last collision time, box 2 comes from below*/
+		if (aabb1.min.y > aabb2.max.y && (t = (aabb1.min.y - aabb2.max.y) / vb.y) > tFirst) {
+			tFirst = t;
+			AEVec2Set(&normal, 0.f, -1.f);
+		}
+
+		if (aabb1.max.y > aabb2.min.y)
+			tLast = AEMin(((aabb1.max.y - aabb2.min.y) / vb.y), tLast);
+	}
+
+	if (vb.y == 0) {
+		if (aabb1.max.y < aabb2.min.y || aabb2.max.y < aabb1.min.y) return false;
+	}
+
+	if (tFirst > tLast) return false;
+
+	/*ALREADY OVERLAPPING*/
+	if (normal.x == 0.f && normal.y == 0.f)
+	{
+		float overlapX = AEMin(aabb1.max.x, aabb2.max.x) - AEMax(aabb1.min.x, aabb2.min.x);
+		float overlapY = AEMin(aabb1.max.y, aabb2.max.y) - AEMax(aabb1.min.y, aabb2.min.y);
+
+		if (overlapX < overlapY)
+			AEVec2Set(&normal, aabb2.min.x + aabb2.max.x >= aabb1.min.x + aabb1.max.x ? 1.f : -1.f, 0.f);
+		else
+			AEVec2Set(&normal, 0.f, aabb2.min.y + aabb2.max.y >= aabb1.min.y + aabb1.max.y ? 1.f : -1.f);
+	}
+
+	pContact->tFirst	= tFirst;
+	pContact->tLast		= tLast;
+	pContact->normal	= normal;
+	return true;
+}
+
+#ifdef COLLISION_SSE
+/**************************************************************************/
+/*!
+	Lane wise operations, overloaded for 4 lanes (SSE) and 8 lanes (AVX)
+	so that the batch test below is written once.
+	The comparisons are ordered, like the scalar ones they are false when
+	an operand is NaN.
+*/
+/**************************************************************************/
+static inline __m128 laneSub	(__m128 a, __m128 b)	{ return _mm_sub_ps		(a, b); }
+static inline __m128 laneDiv	(__m128 a, __m128 b)	{ return _mm_div_ps		(a, b); }
+static inline __m128 laneMin	(__m128 a, __m128 b)	{ return _mm_min_ps		(a, b); }
+static inline __m128 laneMax	(__m128 a, __m128 b)	{ return _mm_max_ps		(a, b); }
+static inline __m128 laneAnd	(__m128 a, __m128 b)	{ return _mm_and_ps		(a, b); }
+static inline __m128 laneOr		(__m128 a, __m128 b)	{ return _mm_or_ps		(a, b); }
+static inline __m128 laneLess	(__m128 a, __m128 b)	{ return _mm_cmplt_ps	(a, b); }
+static inline __m128 laneGreater(__m128 a, __m128 b)	{ return _mm_cmpgt_ps	(a, b); }
+static inline __m128 laneEqual	(__m128 a, __m128 b)	{ return _mm_cmpeq_ps	(a, b); }
+static inline __m128 laneSelect	(__m128 mask, __m128 a, __m128 b)	{ return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a)); }
+
+#ifdef __AVX__
+static inline __m256 laneSub	(__m256 a, __m256 b)	{ return _mm256_sub_ps	(a, b); }
+static inline __m256 laneDiv	(__m256 a, __m256 b)	{ return _mm256_div_ps	(a, b); }
+static inline __m256 laneMin	(__m256 a, __m256 b)	{ return _mm256_min_ps	(a, b); }
+static inline __m256 laneMax	(__m256 a, __m256 b)	{ return _mm256_max_ps	(a, b); }
+static inline __m256 laneAnd	(__m256 a, __m256 b)	{ return _mm256_and_ps	(a, b); }
+static inline __m256 laneOr		(__m256 a, __m256 b)	{ return _mm256_or_ps	(a, b); }
+static inline __m256 laneLess	(__m256 a, __m256 b)	{ return _mm256_cmp_ps	(a, b, _CMP_LT_OQ); }
+static inline __m256 laneGreater(__m256 a, __m256 b)	{ return _mm256_cmp_ps	(a, b, _CMP_GT_OQ); }
+static inline __m256 laneEqual	(__m256 a, __m256 b)	{ return _mm256_cmp_ps	(a, b, _CMP_EQ_OQ); }
+static inline __m256 laneSelect	(__m256 mask, __m256 a, __m256 b)	{ return _mm256_or_ps(_mm256_and_ps(mask, b), _mm256_andnot_ps(mask, a)); }
+#endif // __AVX__
+
+/**************************************************************************/
+/*!
+	CollisionIntersection_RectRect on one lane per box, returns the lanes
+	that do not collide. Every branch of the scalar test becomes a mask and
+	every early return is or-ed into the miss mask. The min and max
+	instructions pick their operands the same way as AEMin and AEMax, so
+	the results are the same bit for bit.
+*/
+/**************************************************************************/
+template <typename LANES>
+static inline LANES collisionRectRectMiss(	LANES min1X, LANES min1Y, LANES max1X, LANES max1Y, LANES vel1X, LANES vel1Y,
+											LANES min2X, LANES min2Y, LANES max2X, LANES max2Y, LANES vel2X, LANES vel2Y,
+											LANES zero, LANES dt)
+{
+	/*STATIC COLLISION*/
+	LANES miss = laneOr(laneOr(laneGreater(min1X, max2X), laneLess(max1X, min2X)),
+						laneOr(laneGreater(min1Y, max2Y), laneLess(max1Y, min2Y)));
+
+	/*DYNAMIC COLLISION*/
+	LANES vbX = laneSub(vel2X, vel1X);
+	LANES vbY = laneSub(vel2Y, vel1Y);
+
+	LANES tFirst	= zero;
+	LANES tLast		= dt;
+	LANES neg, pos, update;
+
+	/*X-AXIS*/
+	neg		= laneLess(vbX, zero);
+	miss	= laneOr(miss, laneAnd(neg, laneGreater(min1X, max2X)));
+	update	= laneAnd(neg, laneLess(max1X, min2X));
+	tFirst	= laneSelect(update, tFirst, laneMax(laneDiv(laneSub(max1X, min2X), vbX), tFirst));
+	update	= laneAnd(neg, laneLess(min1X, max2X));
+	tLast	= laneSelect(update, tLast, laneMin(laneDiv(laneSub(min1X, max2X), vbX), tLast));
+
+	pos		= laneGreater(vbX, zero);
+	miss	= laneOr(miss, laneAnd(pos, laneLess(max1X, min2X)));
+	update	= laneAnd(pos, laneGreater(min1X, max2X));
+	tFirst	= laneSelect(update, tFirst, laneMax(laneDiv(laneSub(min1X, max2X), vbX), tFirst));
+	update	= laneAnd(pos, laneGreater(max1X, min2X));
+	tLast	= laneSelect(update, tLast, laneMin(laneDiv(laneSub(max1X, min2X), vbX), tLast));
+
+	miss	= laneOr(miss, laneAnd(laneEqual(vbX, zero), laneOr(laneLess(max1X, min2X), laneLess(max2X, min1X))));
+
+	/*Y-AXIS*/
+	neg		= laneLess(vbY, zero);
+	miss	= laneOr(miss, laneAnd(neg, laneGreater(min1Y, max2Y)));
+	update	= laneAnd(neg, laneLess(max1Y, min2Y));
+	tFirst	= laneSelect(update, tFirst, laneMax(laneDiv(laneSub(max1Y, min2Y), vbY), tFirst));
+	update	= laneAnd(neg, laneLess(min1Y, max2Y));
+	tLast	= laneSelect(update, tLast, laneMin(laneDiv(laneSub(min1Y, max2Y), vbY), tLast));
+
+	pos		= laneGreater(vbY, zero);
+	miss	= laneOr(miss, laneAnd(pos, laneLess(max1Y, min2Y)));
+	update	= laneAnd(pos, laneGreater(min1Y, max2Y));
+	tFirst	= laneSelect(update, tFirst, laneMax(laneDiv(laneSub(min1Y, max2Y), vbY), tFirst));
+	update	= laneAnd(pos, laneGreater(max1Y, min2Y));
+	tLast	= laneSelect(update, tLast, laneMin(laneDiv(laneSub(max1Y, min2Y), vbY), tLast));
+
+	miss	= laneOr(miss, laneAnd(laneEqual(vbY, zero), laneOr(laneLess(max1Y, min2Y), laneLess(max2Y, min1Y))));
+
+	return laneOr(miss, laneGreater(tFirst, tLast));
+}
+#endif // COLLISION_SSE
+
+// number of bits set in each 4 bit value
+static const unsigned int collisionBitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+/**************************************************************************/
+/*!
+	Tests one rectangle against a batch of rectangles. Bit i of pHitMask,
+	counting from bit 0 of the first word, is set to the result of
+	CollisionIntersection_RectRect(aabb1, vel1, box i, velocity i).
+	pHitMask needs (batch.num + 31) / 32 words. Returns the number of hits.
+*/
+/**************************************************************************/
+unsigned int CollisionIntersection_RectRectBatch(const AABB &aabb1, const AEVec2 &vel1,
+												 const AABBBatch &batch, unsigned int *pHitMask)
+{
+	unsigned int i = 0, hitNum = 0;
+
+	memset(pHitMask, 0, (batch.num + 31) / 32 * sizeof(unsigned int));
+
+#ifdef __AVX__
+	// 8 boxes at a time
+	for (; i + 8 <= batch.num; i += 8)
+	{
+		__m256 miss = collisionRectRectMiss(_mm256_set1_ps(aabb1.min.x),		_mm256_set1_ps(aabb1.min.y),
+											_mm256_set1_ps(aabb1.max.x),		_mm256_set1_ps(aabb1.max.y),
+											_mm256_set1_ps(vel1.x),				_mm256_set1_ps(vel1.y),
+											_mm256_loadu_ps(batch.pMinX + i),	_mm256_loadu_ps(batch.pMinY + i),
+											_mm256_loadu_ps(batch.pMaxX + i),	_mm256_loadu_ps(batch.pMaxY + i),
+											_mm256_loadu_ps(batch.pVelX + i),	_mm256_loadu_ps(batch.pVelY + i),
+											_mm256_setzero_ps(),				_mm256_set1_ps(g_dt));
+
+		unsigned int hit = ~_mm256_movemask_ps(miss) & 0xFF;
+
+		pHitMask[i / 32]	|= hit << (i % 32);
+		hitNum				+= collisionBitCount[hit & 0xF] + collisionBitCount[hit >> 4];
+	}
+#endif // __AVX__
+
+#ifdef COLLISION_SSE
+	// 4 boxes at a time, the boxes left over go through the scalar test
+	for (; i + 4 <= batch.num; i += 4)
+	{
+		__m128 miss = collisionRectRectMiss(_mm_set1_ps(aabb1.min.x),		_mm_set1_ps(aabb1.min.y),
+											_mm_set1_ps(aabb1.max.x),		_mm_set1_ps(aabb1.max.y),
+											_mm_set1_ps(vel1.x),			_mm_set1_ps(vel1.y),
+											_mm_loadu_ps(batch.pMinX + i),	_mm_loadu_ps(batch.pMinY + i),
+											_mm_loadu_ps(batch.pMaxX + i),	_mm_loadu_ps(batch.pMaxY + i),
+											_mm_loadu_ps(batch.pVelX + i),	_mm_loadu_ps(batch.pVelY + i),
+											_mm_setzero_ps(),				_mm_set1_ps(g_dt));
+
+		unsigned int hit = ~_mm_movemask_ps(miss) & 0xF;
+
+		pHitMask[i / 32]	|= hit << (i % 32);
+		hitNum				+= collisionBitCount[hit];
+	}
+#endif // COLLISION_SSE
+
+	for (; i < batch.num; ++i)
+	{
+		AABB	aabb2;
+		AEVec2	vel2;
+
+		AEVec2Set(&aabb2.min,	batch.pMinX[i], batch.pMinY[i]);
+		AEVec2Set(&aabb2.max,	batch.pMaxX[i], batch.pMaxY[i]);
+		AEVec2Set(&vel2,		batch.pVelX[i], batch.pVelY[i]);
+
+		if (CollisionIntersection_RectRect(aabb1, vel1, aabb2, vel2))
+		{
+			pHitMask[i / 32] |= 1u << (i % 32);
+			++hitNum;
+		}
+	}
+
+	return hitNum;
+}
+
+/**************************************************************************/
+/*!
+	Orders hits by first time of contact, equal times by box index
+*/
+/**************************************************************************/
+static bool collisionHitEarlier(const RectRectHit &hit1, const RectRectHit &hit2)
+{
+	if (hit1.contact.tFirst != hit2.contact.tFirst)
+		return hit1.contact.tFirst < hit2.contact.tFirst;
+
+	return hit1.index < hit2.index;
+}
+
+/**************************************************************************/
+/*!
+	Swept test of one rectangle against a batch of rectangles.
+	pHit must hold batch.num entries, the hits are written to it sorted by
+	their first time of contact. Returns the number of hits.
+*/
+/**************************************************************************/
+unsigned int CollisionIntersection_RectRectSweptBatch(const AABB &aabb1, const AEVec2 &vel1,
+													  const AABBBatch &batch, RectRectHit *pHit)
+{
+	unsigned int hitNum = 0;
+
+	for (unsigned int i = 0; i < batch.num; ++i)
+	{
+		AABB	aabb2;
+		AEVec2	vel2;
+
+		AEVec2Set(&aabb2.min,	batch.pMinX[i], batch.pMinY[i]);
+		AEVec2Set(&aabb2.max,	batch.pMaxX[i], batch.pMaxY[i]);
+		AEVec2Set(&vel2,		batch.pVelX[i], batch.pVelY[i]);
+
+		if (CollisionIntersection_RectRectSwept(aabb1, vel1, aabb2, vel2, &pHit[hitNum].contact))
+			pHit[hitNum++].index = i;
+	}
+
+	std::sort(pHit, pHit + hitNum, collisionHitEarlier);
+
+	return hitNum;
+}
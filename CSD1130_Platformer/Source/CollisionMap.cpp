@@ -0,0 +1,123 @@
+/******************************************************************************/
+/*!
+\file		CollisionMap.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Binary collision map stored as one bit per cell.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+
+/******************************************************************************/
+/*!
+	Allocates a width by height map with every cell cleared
+*/
+/******************************************************************************/
+bool CollisionMapInit(CollisionMap *pMap, int width, int height)
+{
+	pMap->width		= width;
+	pMap->height	= height;
+	pMap->rowWords	= (width + 31) / 32;
+
+	// at least one word, so that a probe outside of an empty map still has a word to read
+	size_t words	= (size_t)pMap->rowWords * height;
+	pMap->pWords	= (unsigned int*)calloc(words ? words : 1, sizeof(unsigned int));
+
+	return 0 != pMap->pWords;
+}
+
+/******************************************************************************/
+/*!
+	Frees the map
+*/
+/******************************************************************************/
+void CollisionMapFree(CollisionMap *pMap)
+{
+	free(pMap->pWords);
+
+	pMap->pWords	= 0;
+	pMap->width		= 0;
+	pMap->height	= 0;
+	pMap->rowWords	= 0;
+}
+
+/******************************************************************************/
+/*!
+	Moves a box by delta through the map and returns the fraction of delta
+	it travels before it first enters a collision cell, 1 if it never does.
+	pNormal is set to the side of the cell that was hit, or to zero.
+
+	The leading edges step from one grid line to the next in the order the
+	box reaches them, like a DDA walk along delta. Each time a leading edge
+	crosses a grid line, the cells it enters are the ones on the other side
+	of the line that the box spans at that moment. Cells the box already
+	overlaps are not hits, and neither are cells it only touches.
+*/
+/******************************************************************************/
+float CollisionMapSweep(const CollisionMap &map, const AABB &box, const AEVec2 &delta, AEVec2 *pNormal)
+{
+	int		stepX	= delta.x > 0.f ? 1 : (delta.x < 0.f ? -1 : 0);
+	int		stepY	= delta.y > 0.f ? 1 : (delta.y < 0.f ? -1 : 0);
+
+	// leading edges and the first grid line each one reaches
+	float	leadX	= stepX > 0 ? box.max.x : box.min.x;
+	float	leadY	= stepY > 0 ? box.max.y : box.min.y;
+	int		lineX	= stepX > 0 ? (int)ceilf(leadX) : (int)floorf(leadX);
+	int		lineY	= stepY > 0 ? (int)ceilf(leadY) : (int)floorf(leadY);
+
+	// time each leading edge reaches its next grid line, past 1 if it does not move
+	float	tX		= stepX ? (lineX - leadX) / delta.x : 2.f;
+	float	tY		= stepY ? (lineY - leadY) / delta.y : 2.f;
+
+	AEVec2Zero(pNormal);
+
+	while (tX <= 1.f || tY <= 1.f)
+	{
+		if (tX <= tY)
+		{
+			/*LEADING EDGE ENTERS A COLUMN*/
+			int x	= stepX > 0 ? lineX : lineX - 1;
+			int y0	= (int)floorf(box.min.y + delta.y * tX);
+			int y1	= (int)ceilf (box.max.y + delta.y * tX) - 1;
+
+			// a row entered at the same moment counts, or the box could slip through a corner
+			if (tY == tX)
+				stepY > 0 ? ++y1 : --y0;
+
+			for (int y = y0; y <= y1; ++y)
+				if (CollisionMapGet(map, x, y))
+				{
+					AEVec2Set(pNormal, (float)-stepX, 0.f);
+					return tX;
+				}
+
+			lineX	+= stepX;
+			tX		= (lineX - leadX) / delta.x;
+		}
+		else
+		{
+			/*LEADING EDGE ENTERS A ROW*/
+			int y	= stepY > 0 ? lineY : lineY - 1;
+			int x0	= (int)floorf(box.min.x + delta.x * tY);
+			int x1	= (int)ceilf (box.max.x + delta.x * tY) - 1;
+
+			for (int x = x0; x <= x1; ++x)
+				if (CollisionMapGet(map, x, y))
+				{
+					AEVec2Set(pNormal, 0.f, (float)-stepY);
+					return tY;
+				}
+
+			lineY	+= stepY;
+			tY		= (lineY - leadY) / delta.y;
+		}
+	}
+
+	return 1.f;
+}
@@ -0,0 +1,223 @@
+/******************************************************************************/
+/*!
+\file		ContactQueue.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Contact events written by the rect-rect narrowphase and read by
+			the gameplay response afterwards.
+
+			Enter and stay are told apart with a sorted list of the pairs
+			that touched last frame, each touching pair is looked up in it.
+			The entries nobody looked up are the pairs that stopped touching.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+#include <algorithm>
+
+/******************************************************************************/
+/*!
+	Defines
+*/
+/******************************************************************************/
+const unsigned int	CONTACT_QUEUE_GROW_MIN	= 256;	// first capacity of the event and pair lists
+
+/******************************************************************************/
+/*!
+	Key of a pair in the sorted pair lists
+*/
+/******************************************************************************/
+static unsigned long long contactQueueKey(unsigned int a, unsigned int b)
+{
+	return (unsigned long long)a << 32 | b;
+}
+
+/******************************************************************************/
+/*!
+	Reserves the first lists
+*/
+/******************************************************************************/
+bool ContactQueueInit(ContactQueue *pQueue)
+{
+	memset(pQueue, 0, sizeof(ContactQueue));
+
+	return ContactQueueBegin(pQueue, CONTACT_QUEUE_GROW_MIN / 2);
+}
+
+/******************************************************************************/
+/*!
+	Frees the lists
+*/
+/******************************************************************************/
+void ContactQueueFree(ContactQueue *pQueue)
+{
+	free(pQueue->pEvent);
+	free(pQueue->pPrev);
+	free(pQueue->pCurr);
+	free(pQueue->pPrevSeen);
+
+	memset(pQueue, 0, sizeof(ContactQueue));
+}
+
+/******************************************************************************/
+/*!
+	Forgets the pairs that touched, the next frame only has enter events
+*/
+/******************************************************************************/
+void ContactQueueClear(ContactQueue *pQueue)
+{
+	pQueue->slotNum		= 0;
+	pQueue->eventNum	= 0;
+	pQueue->touchNum	= 0;
+	pQueue->prevNum		= 0;
+}
+
+/******************************************************************************/
+/*!
+	Makes room for slotNum tests and the exits of last frame, and marks
+	every slot as not touching
+*/
+/******************************************************************************/
+bool ContactQueueBegin(ContactQueue *pQueue, unsigned int slotNum)
+{
+	unsigned int eventNum = slotNum + pQueue->prevNum;
+
+	if (eventNum > pQueue->eventMax)
+	{
+		unsigned int max = pQueue->eventMax ? pQueue->eventMax : CONTACT_QUEUE_GROW_MIN;
+		while (max < eventNum)
+			max *= 2;
+
+		ContactEvent *pEvent = (ContactEvent*)realloc(pQueue->pEvent, max * sizeof(ContactEvent));
+		if (0 == pEvent)
+			return false;
+		pQueue->pEvent		= pEvent;
+		pQueue->eventMax	= max;
+	}
+
+	// every touching slot becomes a pair of this frame
+	if (slotNum > pQueue->pairMax)
+	{
+		unsigned int max = pQueue->pairMax ? pQueue->pairMax : CONTACT_QUEUE_GROW_MIN;
+		while (max < slotNum)
+			max *= 2;
+
+		unsigned long long *pPrev = (unsigned long long*)realloc(pQueue->pPrev, max * sizeof(unsigned long long));
+		if (0 == pPrev)
+			return false;
+		pQueue->pPrev = pPrev;
+
+		unsigned long long *pCurr = (unsigned long long*)realloc(pQueue->pCurr, max * sizeof(unsigned long long));
+		if (0 == pCurr)
+			return false;
+		pQueue->pCurr = pCurr;
+
+		unsigned char *pPrevSeen = (unsigned char*)realloc(pQueue->pPrevSeen, max * sizeof(unsigned char));
+		if (0 == pPrevSeen)
+			return false;
+		pQueue->pPrevSeen = pPrevSeen;
+
+		pQueue->pairMax = max;
+	}
+
+	for (unsigned int i = 0; i < slotNum; ++i)
+		pQueue->pEvent[i].type = CONTACT_NONE;
+
+	pQueue->slotNum		= slotNum;
+	pQueue->eventNum	= 0;
+	pQueue->touchNum	= 0;
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Packs the touching slots into events, adds the exits and keeps the
+	touching pairs for the next frame. Returns the number of events.
+*/
+/******************************************************************************/
+unsigned int ContactQueueEnd(ContactQueue *pQueue)
+{
+	unsigned int	i, num = 0, touchNum;
+	ContactEvent	*pEvent = pQueue->pEvent;
+
+	memset(pQueue->pPrevSeen, 0, pQueue->prevNum * sizeof(unsigned char));
+
+	/*ENTER AND STAY*/
+	for (i = 0; i < pQueue->slotNum; ++i)
+	{
+		if (CONTACT_NONE == pEvent[i].type)
+			continue;
+
+		unsigned long long	key		= contactQueueKey(pEvent[i].a, pEvent[i].b);
+		unsigned long long	*pPrev	= std::lower_bound(pQueue->pPrev, pQueue->pPrev + pQueue->prevNum, key);
+
+		if (pPrev != pQueue->pPrev + pQueue->prevNum && *pPrev == key)
+		{
+			pEvent[i].type								= CONTACT_STAY;
+			pQueue->pPrevSeen[pPrev - pQueue->pPrev]	= 1;
+		}
+
+		pQueue->pCurr[num]	= key;
+		pEvent[num++]		= pEvent[i];
+	}
+
+	touchNum = num;
+
+	/*EXIT*/
+	for (i = 0; i < pQueue->prevNum; ++i)
+	{
+		if (pQueue->pPrevSeen[i])
+			continue;
+
+		ContactEvent *pExit = pEvent + num++;
+
+		pExit->a			= (unsigned int)(pQueue->pPrev[i] >> 32);
+		pExit->b			= (unsigned int)pQueue->pPrev[i];
+		pExit->type			= CONTACT_EXIT;
+		pExit->timeOfImpact	= 0.f;
+		pExit->slot			= pQueue->slotNum;
+
+		AEVec2Zero(&pExit->normal);
+	}
+
+	// the pairs of this frame are the previous ones of the next
+	std::sort(pQueue->pCurr, pQueue->pCurr + touchNum);
+	std::swap(pQueue->pPrev, pQueue->pCurr);
+
+	pQueue->prevNum		= touchNum;
+	pQueue->slotNum		= 0;
+	pQueue->eventNum	= num;
+	pQueue->touchNum	= touchNum;
+
+	return num;
+}
+
+/******************************************************************************/
+/*!
+	Orders contacts by time of impact, equal times by slot
+*/
+/******************************************************************************/
+static bool contactQueueEarlier(const ContactEvent &event1, const ContactEvent &event2)
+{
+	if (event1.timeOfImpact != event2.timeOfImpact)
+		return event1.timeOfImpact < event2.timeOfImpact;
+
+	return event1.slot < event2.slot;
+}
+
+/******************************************************************************/
+/*!
+	Sorts the enter and stay events of the frame by time of impact, so they
+	can be applied in the order they happened. The exits stay at the end.
+*/
+/******************************************************************************/
+void ContactQueueSortByTime(ContactQueue *pQueue)
+{
+	std::sort(pQueue->pEvent, pQueue->pEvent + pQueue->touchNum, contactQueueEarlier);
+}
@@ -0,0 +1,211 @@
+/******************************************************************************/
+/*!
+\file		DistanceField.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Distance to the nearest collision cell and free runs per direction,
+			built from the binary collision map.
+
+			The distances come from two raster passes, the first one taking
+			the smallest neighbour above and to the left plus one, the second
+			one the same from below and to the right. With all 8 neighbours
+			this is exact for the chessboard distance.
+			A changed cell can only change the distances of cells that are
+			no further from it than the largest distance in the field, so
+			only that window is computed again.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+
+/******************************************************************************/
+/*!
+	Smallest of a distance and a neighbour distance plus one, neighbours
+	outside of the map are ignored
+*/
+/******************************************************************************/
+static unsigned int distanceFieldNeighbour(const DistanceField *pField, unsigned int distance, int X, int Y)
+{
+	if ((unsigned int)X >= (unsigned int)pField->width || (unsigned int)Y >= (unsigned int)pField->height)
+		return distance;
+
+	unsigned int neighbour = pField->pDistance[Y * pField->width + X] + 1u;
+
+	return neighbour < distance ? neighbour : distance;
+}
+
+/******************************************************************************/
+/*!
+	Computes the distances of the cells in [x0, x1] x [y0, y1] again.
+	Cells around the window keep their distances and act as sources.
+	Returns the largest distance in the window.
+*/
+/******************************************************************************/
+static unsigned int distanceFieldChamfer(DistanceField *pField, const CollisionMap &map, int x0, int y0, int x1, int y1)
+{
+	int				x, y;
+	unsigned int	distance, distanceMax = 0;
+
+	for (y = y0; y <= y1; ++y)
+		for (x = x0; x <= x1; ++x)
+			pField->pDistance[y * pField->width + x] = CollisionMapGet(map, x, y) ? 0 : (unsigned char)DISTANCE_FIELD_MAX;
+
+	/*FORWARD PASS*/
+	for (y = y0; y <= y1; ++y)
+		for (x = x0; x <= x1; ++x)
+		{
+			distance = pField->pDistance[y * pField->width + x];
+			distance = distanceFieldNeighbour(pField, distance, x - 1,	y		);
+			distance = distanceFieldNeighbour(pField, distance, x - 1,	y - 1	);
+			distance = distanceFieldNeighbour(pField, distance, x,		y - 1	);
+			distance = distanceFieldNeighbour(pField, distance, x + 1,	y - 1	);
+
+			pField->pDistance[y * pField->width + x] = (unsigned char)distance;
+		}
+
+	/*BACKWARD PASS*/
+	for (y = y1; y >= y0; --y)
+		for (x = x1; x >= x0; --x)
+		{
+			distance = pField->pDistance[y * pField->width + x];
+			distance = distanceFieldNeighbour(pField, distance, x + 1,	y		);
+			distance = distanceFieldNeighbour(pField, distance, x + 1,	y + 1	);
+			distance = distanceFieldNeighbour(pField, distance, x,		y + 1	);
+			distance = distanceFieldNeighbour(pField, distance, x - 1,	y + 1	);
+
+			pField->pDistance[y * pField->width + x] = (unsigned char)distance;
+
+			distanceMax = distance > distanceMax ? distance : distanceMax;
+		}
+
+	return distanceMax;
+}
+
+/******************************************************************************/
+/*!
+	Counts the free cells of row Y from each end
+*/
+/******************************************************************************/
+static void distanceFieldRow(DistanceField *pField, const CollisionMap &map, int Y)
+{
+	unsigned char	*pLeft	= pField->pRun[RUN_LEFT] + Y * pField->width;
+	unsigned char	*pRight	= pField->pRun[RUN_RIGHT] + Y * pField->width;
+	unsigned int	run;
+	int				x;
+
+	for (x = 0, run = 0; x < pField->width; ++x)
+	{
+		run = CollisionMapGet(map, x, Y) ? 0 : (run < DISTANCE_FIELD_MAX ? run + 1 : run);
+		pLeft[x] = (unsigned char)run;
+	}
+
+	for (x = pField->width - 1, run = 0; x >= 0; --x)
+	{
+		run = CollisionMapGet(map, x, Y) ? 0 : (run < DISTANCE_FIELD_MAX ? run + 1 : run);
+		pRight[x] = (unsigned char)run;
+	}
+}
+
+/******************************************************************************/
+/*!
+	Counts the free cells of column X from each end
+*/
+/******************************************************************************/
+static void distanceFieldColumn(DistanceField *pField, const CollisionMap &map, int X)
+{
+	unsigned char	*pDown	= pField->pRun[RUN_DOWN] + X;
+	unsigned char	*pUp	= pField->pRun[RUN_UP] + X;
+	unsigned int	run;
+	int				y;
+
+	for (y = 0, run = 0; y < pField->height; ++y)
+	{
+		run = CollisionMapGet(map, X, y) ? 0 : (run < DISTANCE_FIELD_MAX ? run + 1 : run);
+		pDown[y * pField->width] = (unsigned char)run;
+	}
+
+	for (y = pField->height - 1, run = 0; y >= 0; --y)
+	{
+		run = CollisionMapGet(map, X, y) ? 0 : (run < DISTANCE_FIELD_MAX ? run + 1 : run);
+		pUp[y * pField->width] = (unsigned char)run;
+	}
+}
+
+/******************************************************************************/
+/*!
+	Allocates the tables for the size of the map and builds them
+*/
+/******************************************************************************/
+bool DistanceFieldInit(DistanceField *pField, const CollisionMap &map)
+{
+	size_t cellNum = (size_t)map.width * map.height;
+
+	memset(pField, 0, sizeof(DistanceField));
+
+	pField->width	= map.width;
+	pField->height	= map.height;
+
+	// one block for the distances and the runs
+	pField->pDistance = (unsigned char*)malloc((RUN_DIRECTION_NUM + 1) * cellNum + 1);
+	if (0 == pField->pDistance)
+		return false;
+
+	for (unsigned int i = 0; i < RUN_DIRECTION_NUM; ++i)
+		pField->pRun[i] = pField->pDistance + (i + 1) * cellNum;
+
+	pField->distanceMax = distanceFieldChamfer(pField, map, 0, 0, map.width - 1, map.height - 1);
+
+	for (int y = 0; y < map.height; ++y)
+		distanceFieldRow(pField, map, y);
+
+	for (int x = 0; x < map.width; ++x)
+		distanceFieldColumn(pField, map, x);
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Frees the tables
+*/
+/******************************************************************************/
+void DistanceFieldFree(DistanceField *pField)
+{
+	free(pField->pDistance);
+
+	memset(pField, 0, sizeof(DistanceField));
+}
+
+/******************************************************************************/
+/*!
+	Brings the tables up to date after cell (X, Y) of the map changed.
+	The runs of its row and column are counted again, and the distances of
+	the cells it can reach.
+*/
+/******************************************************************************/
+void DistanceFieldUpdate(DistanceField *pField, const CollisionMap &map, int X, int Y)
+{
+	if ((unsigned int)X >= (unsigned int)pField->width || (unsigned int)Y >= (unsigned int)pField->height)
+		return;
+
+	distanceFieldRow	(pField, map, Y);
+	distanceFieldColumn	(pField, map, X);
+
+	// a cell further away than every distance has a nearer collision cell, before and after the change
+	int radius	= (int)pField->distanceMax;
+	int x0		= X > radius ? X - radius : 0;
+	int y0		= Y > radius ? Y - radius : 0;
+	int x1		= X + radius < pField->width ? X + radius : pField->width - 1;
+	int y1		= Y + radius < pField->height ? Y + radius : pField->height - 1;
+
+	unsigned int distanceMax = distanceFieldChamfer(pField, map, x0, y0, x1, y1);
+
+	// a bound is enough, the largest distance outside of the window is not known
+	if (distanceMax > pField->distanceMax)
+		pField->distanceMax = distanceMax;
+}
@@ -20,7 +20,8 @@ prior written consent of DigiPen Institute of Technology is prohibited.
 */
 /******************************************************************************/
 void GameStateMenuLoad(void) {
-	//...nothing
+	// both levels are read while the menu is showing
+	GameStatePlatformPreload();
 }
 
 /******************************************************************************/
@@ -0,0 +1,2220 @@
+/******************************************************************************/
+/*!
+\file		HeadlessMain.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Runs the platformer simulation without a window for profiling.
+
+			Usage: platformer_headless [level file] [frames] [speed]
+			       platformer_headless -broadphase [boxes] [frames]
+			       platformer_headless -rectbatch [boxes] [rounds]
+			       platformer_headless -probes [map size] [probes]
+			       platformer_headless -contacts [boxes] [frames]
+			       platformer_headless -colliders [level file] [sweeps]
+			       platformer_headless -rays [level file] [rays]
+			       platformer_headless -distance [map size] [cell changes]
+			       platformer_headless -convert [text level file] [binary level file]
+			       platformer_headless -levelload [map size] [file name without extension]
+			       platformer_headless -textparse [map size] [file name without extension]
+			       platformer_headless -preload [map size] [file name without extension] [frames]
+			       platformer_headless -transition [switches]
+			       platformer_headless -churn [pool chunks] [spawns]
+			       platformer_headless -layout [instances] [instance updates]
+			       platformer_headless -fused [tiles] [frames]
+			       platformer_headless -pool [instances] [frames] [destroys per frame]
+			       platformer_headless -coins [tiles] [frames]
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+/******************************************************************************/
+
+#include "PlatformSim.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Globals
+float	g_dt;
+
+/******************************************************************************/
+/*!
+	Scripted input: hold right, then left, then nothing for four seconds
+	each, and press jump every 45 frames
+*/
+/******************************************************************************/
+static void ScriptedInput(unsigned int frame, PlatformSimInput *pInput)
+{
+	unsigned int phase = (frame / 240) % 3;
+
+	pInput->right	= phase == 0;
+	pInput->left	= phase == 1;
+	pInput->jump	= frame % 45 == 0;
+}
+
+/******************************************************************************/
+/*!
+	Starts counting the cache misses of this thread, returns -1 where the
+	hardware counters cannot be read
+*/
+/******************************************************************************/
+static int CacheMissStart(void)
+{
+#ifdef __linux__
+	perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(perf_event_attr));
+	attr.type			= PERF_TYPE_HARDWARE;
+	attr.size			= sizeof(perf_event_attr);
+	attr.config			= PERF_COUNT_HW_CACHE_MISSES;
+	attr.exclude_kernel	= 1;
+	attr.exclude_hv		= 1;
+
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+	return -1;
+#endif
+}
+
+/******************************************************************************/
+/*!
+	Stops a counter from CacheMissStart, returns its count or -1
+*/
+/******************************************************************************/
+static long long CacheMissStop(int counter)
+{
+	long long count = -1;
+
+#ifdef __linux__
+	if (counter >= 0)
+	{
+		if (read(counter, &count, sizeof(long long)) != (ssize_t)sizeof(long long))
+			count = -1;
+
+		close(counter);
+	}
+#else
+	(void)counter;
+#endif
+
+	return count;
+}
+
+/******************************************************************************/
+/*!
+	64-bit FNV-1a over a block of memory
+*/
+/******************************************************************************/
+static u64 Checksum(u64 hash, const void *pData, size_t size)
+{
+	const u8 *pByte = (const u8*)pData;
+
+	for (size_t i = 0; i < size; ++i)
+		hash = (hash ^ pByte[i]) * 0x100000001B3ULL;
+
+	return hash;
+}
+
+/******************************************************************************/
+/*!
+	Checksum of the state a frame leaves behind: the live instances in live
+	list order, the active particles and the level counters
+*/
+/******************************************************************************/
+static u64 StateChecksum(void)
+{
+	u64 hash = 0xCBF29CE484222325ULL;
+
+	for (unsigned int k = 0; k < gGameObjInstNum; ++k)
+	{
+		unsigned int inst = gGameObjInstLiveList[k];
+
+		hash = Checksum(hash, &gameObjInst(inst)->pObject->type,	sizeof(unsigned int));
+		hash = Checksum(hash, gameObjInstFlag(inst),				sizeof(unsigned int));
+		hash = Checksum(hash, gameObjInstPos(inst),					sizeof(AEVec2));
+		hash = Checksum(hash, gameObjInstVel(inst),					sizeof(AEVec2));
+	}
+
+	for (unsigned int i = 0; i < PARTICLES_MAX; ++i)
+	{
+		Particle *particle = gParticlesList + i;
+
+		if (particle->flag)
+		{
+			hash = Checksum(hash, &particle->posCurr,	sizeof(AEVec2));
+			hash = Checksum(hash, &particle->scale,		sizeof(f32));
+		}
+	}
+
+	hash = Checksum(hash, &HeroLives,	sizeof(int));
+	hash = Checksum(hash, &TotalCoins,	sizeof(int));
+
+	return hash;
+}
+
+/******************************************************************************/
+/*!
+	Fills the instance pool to a share of its slots, then spawns an
+	instance and despawns a random one, spawnNum times. The same churn
+	runs on a plain array of flags that is searched from the start for a
+	free slot, the way instances were created before the free slot stack.
+	Returns the nanoseconds per spawn and despawn, of the pool and of the
+	search.
+*/
+/******************************************************************************/
+static bool ChurnRound(unsigned int capacity, unsigned int percent, unsigned int spawnNum, double *pPoolNs, double *pSearchNs)
+{
+	std::vector<GameObjInstHandle>	handle;
+	AEVec2							pos;
+
+	AEVec2Set(&pos, 2.5f, 2.5f);
+
+	// the pool grows to its full size first, the slots above the share are freed again
+	for (unsigned int i = 0; i < capacity; ++i)
+	{
+		GameObjInstHandle h = gameObjInstCreate(TYPE_OBJECT_COIN, 1.f, &pos, 0, 0.f, STATE_NONE);
+
+		if (GAME_OBJ_INST_NONE == h)
+			return false;
+
+		handle.push_back(h);
+	}
+
+	unsigned int liveNum = capacity * percent / 100;
+
+	while (handle.size() > liveNum)
+	{
+		gameObjInstDestroy(gameObjInstResolve(handle.back()));
+		handle.pop_back();
+	}
+
+	/*POOL*/
+	srand(1);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < spawnNum; ++i)
+	{
+		handle.push_back(gameObjInstCreate(TYPE_OBJECT_COIN, 1.f, &pos, 0, 0.f, STATE_NONE));
+
+		unsigned int k = (unsigned int)rand() % handle.size();
+
+		gameObjInstDestroy(gameObjInstResolve(handle[k]));
+		handle[k] = handle.back();
+		handle.pop_back();
+	}
+
+	std::chrono::duration<double> poolSeconds = std::chrono::steady_clock::now() - start;
+
+	/*SEARCH FOR A FREE SLOT*/
+	std::vector<unsigned int> flag(capacity, 0), live;
+
+	for (unsigned int i = 0; i < liveNum; ++i)
+	{
+		flag[i] = FLAG_ACTIVE;
+		live.push_back(i);
+	}
+
+	srand(1);
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < spawnNum; ++i)
+	{
+		unsigned int slot = 0;
+
+		while (slot < capacity && flag[slot])
+			++slot;
+
+		flag[slot] = FLAG_ACTIVE;
+		live.push_back(slot);
+
+		unsigned int k = (unsigned int)rand() % live.size();
+
+		flag[live[k]]	= 0;
+		live[k]			= live.back();
+		live.pop_back();
+	}
+
+	std::chrono::duration<double> searchSeconds = std::chrono::steady_clock::now() - start;
+
+	*pPoolNs	= poolSeconds.count() * 1e9 / spawnNum;
+	*pSearchNs	= searchSeconds.count() * 1e9 / spawnNum;
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Times spawning and despawning with the pool 0%, 50% and 99% full
+*/
+/******************************************************************************/
+static int ChurnBenchmark(unsigned int chunkNum, unsigned int spawnNum)
+{
+	const char		*FileName		= "../Resources/Levels/Exported.txt";
+	unsigned int	capacity		= chunkNum * GAME_OBJ_INST_CHUNK_SIZE;
+	unsigned int	percent[]		= { 0, 50, 99 };
+
+	PRINT("Pool:        %u slots, %u spawns and despawns per fill\n", capacity, spawnNum);
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		double poolNs = 0.0, searchNs = 0.0;
+
+		// a level only provides the objects, no instance of it is created
+		if (!PlatformSimLoad(FileName))
+		{
+			PRINT("Could not load level %s\n", FileName);
+			PlatformSimUnload();
+			return 1;
+		}
+
+		bool filled = ChurnRound(capacity, percent[i], spawnNum, &poolNs, &searchNs);
+
+		PlatformSimFree();
+		PlatformSimUnload();
+
+		if (!filled)
+		{
+			PRINT("Could not fill the pool\n");
+			return 1;
+		}
+
+		PRINT("%3u%% full:   %.1f ns per spawn and despawn, %.1f ns searching for a free slot\n", percent[i], poolNs, searchNs);
+	}
+
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	An object instance as it was stored before the pool was split into
+	one array per field
+*/
+/******************************************************************************/
+struct LegacyGameObjInst
+{
+	GameObj *		pObject;
+	unsigned int	flag;
+	float			scale;
+	AEVec2			posCurr;
+	AEVec2			velCurr;
+	float			dirCurr;
+	AEMtx33			transform;
+	AABB			boundingBox;
+	enum			DIRECTION face;
+	int				gridCollisionFlag;
+	int				gridCollisionFlagPrev;
+	void*			pUserData;
+	enum			STATE state;
+	enum			INNER_STATE innerState;
+	double			counter;
+};
+
+/******************************************************************************/
+/*!
+	Runs the OBJECT PHYSICS and UPDATE POSITION passes over instNum
+	enemies, once on an array of whole instances and once on the pool's
+	field arrays, and checks that both end in the same positions and
+	boxes
+*/
+/******************************************************************************/
+static int LayoutBenchmark(unsigned int instNum, unsigned int updateNum)
+{
+	const char		*FileName	= "../Resources/Levels/Exported.txt";
+	unsigned int	frameNum	= updateNum / (instNum ? instNum : 1);
+
+	if (!PlatformSimLoad(FileName))
+	{
+		PRINT("Could not load level %s\n", FileName);
+		PlatformSimUnload();
+		return 1;
+	}
+
+	std::vector<LegacyGameObjInst> legacy(instNum);
+
+	// the level only provides the objects, the pool holds nothing but these instances
+	for (unsigned int i = 0; i < instNum; ++i)
+	{
+		AEVec2 pos, vel;
+
+		AEVec2Set(&pos, (f32)(i % 100), (f32)(i / 100 % 100));
+		AEVec2Set(&vel, (f32)(i % 7) - 3.f, 0.f);
+
+		if (GAME_OBJ_INST_NONE == gameObjInstCreate(TYPE_OBJECT_ENEMY1, 1.f, &pos, &vel, 0.f, STATE_NONE))
+		{
+			PRINT("Could not create %u instances\n", instNum);
+			PlatformSimUnload();
+			return 1;
+		}
+
+		memset(&legacy[i], 0, sizeof(LegacyGameObjInst));
+		legacy[i].pObject	= gGameObjList + TYPE_OBJECT_ENEMY1;
+		legacy[i].flag		= FLAG_ACTIVE | FLAG_VISIBLE;
+		legacy[i].scale		= 1.f;
+		legacy[i].posCurr	= pos;
+		legacy[i].velCurr	= vel;
+	}
+
+	/*WHOLE INSTANCES*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		for (unsigned int i = 0; i < instNum; ++i)
+		{
+			LegacyGameObjInst *pInst = legacy.data() + i;
+
+			if (0 == (pInst->flag & FLAG_ACTIVE) || pInst->pObject->type == TYPE_OBJECT_COIN)
+				continue;
+
+			pInst->velCurr.y = GRAVITY * g_dt + pInst->velCurr.y;
+		}
+
+		for (unsigned int i = 0; i < instNum; ++i)
+		{
+			LegacyGameObjInst *pInst = legacy.data() + i;
+
+			if (0 == (pInst->flag & FLAG_ACTIVE))
+				continue;
+
+			pInst->posCurr.x = pInst->velCurr.x * g_dt + pInst->posCurr.x;
+			pInst->posCurr.y = pInst->velCurr.y * g_dt + pInst->posCurr.y;
+
+			AEVec2Set(&pInst->boundingBox.min, -BOUNDING_RECT_SIZE / 2.f + pInst->posCurr.x,	-BOUNDING_RECT_SIZE / 2.f + pInst->posCurr.y);
+			AEVec2Set(&pInst->boundingBox.max, BOUNDING_RECT_SIZE / 2.f + pInst->posCurr.x,		BOUNDING_RECT_SIZE / 2.f + pInst->posCurr.y	);
+		}
+	}
+
+	std::chrono::duration<double> legacySeconds = std::chrono::steady_clock::now() - start;
+
+	/*FIELD ARRAYS*/
+	// the instances were created into slots 0 to instNum - 1, chunk by chunk
+	unsigned int chunkNum = (instNum + GAME_OBJ_INST_CHUNK_MASK) >> GAME_OBJ_INST_CHUNK_SHIFT;
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		for (unsigned int c = 0; c < chunkNum; ++c)
+		{
+			GameObjInstChunk *pChunk = gGameObjInstChunks[c];
+
+			for (unsigned int i = 0; i < GAME_OBJ_INST_CHUNK_SIZE; ++i)
+				if (pChunk->flag[i] & FLAG_ACTIVE)
+					pChunk->velCurr[i].y = GRAVITY * g_dt + pChunk->velCurr[i].y;
+		}
+
+		for (unsigned int c = 0; c < chunkNum; ++c)
+		{
+			GameObjInstChunk *pChunk = gGameObjInstChunks[c];
+
+			for (unsigned int i = 0; i < GAME_OBJ_INST_CHUNK_SIZE; ++i)
+			{
+				if (0 == (pChunk->flag[i] & FLAG_ACTIVE))
+					continue;
+
+				AEVec2 *pPos = pChunk->posCurr + i;
+
+				pPos->x = pChunk->velCurr[i].x * g_dt + pPos->x;
+				pPos->y = pChunk->velCurr[i].y * g_dt + pPos->y;
+
+				AEVec2Set(&pChunk->boundingBox[i].min, -BOUNDING_RECT_SIZE / 2.f + pPos->x,	-BOUNDING_RECT_SIZE / 2.f + pPos->y);
+				AEVec2Set(&pChunk->boundingBox[i].max, BOUNDING_RECT_SIZE / 2.f + pPos->x,	BOUNDING_RECT_SIZE / 2.f + pPos->y	);
+			}
+		}
+	}
+
+	std::chrono::duration<double> fieldSeconds = std::chrono::steady_clock::now() - start;
+
+	bool match = true;
+
+	for (unsigned int i = 0; i < instNum && match; ++i)
+		match = 0 == memcmp(&legacy[i].posCurr, gameObjInstPos(i), sizeof(AEVec2)) &&
+				0 == memcmp(&legacy[i].boundingBox, gameObjInstBoundingBox(i), sizeof(AABB));
+
+	PlatformSimFree();
+	PlatformSimUnload();
+
+	double updates = (double)frameNum * instNum;
+
+	PRINT("Instances:   %u for %u frames, %u bytes per whole instance, positions %s\n", instNum, frameNum,
+		(unsigned int)sizeof(LegacyGameObjInst), match ? "match" : "DIFFER");
+	PRINT("Whole:       %.2f ns per instance update\n", legacySeconds.count() * 1e9 / updates);
+	PRINT("Fields:      %.2f ns per instance update\n", fieldSeconds.count() * 1e9 / updates);
+
+	return match ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Writes a text level made of tileNum x tileNum copies of another level.
+	Only the first copy keeps its hero.
+*/
+/******************************************************************************/
+static bool WriteTiledLevel(const char *SourceName, const char *FileName, int tileNum)
+{
+	if (!ImportMapDataFromFile(SourceName))
+	{
+		FreeMapData();
+		return false;
+	}
+
+	int				width	= MapData.width * tileNum;
+	int				height	= MapData.height * tileNum;
+	std::ofstream	stream{ FileName, std::ios::trunc };
+	std::string		row;
+
+	stream << "Width " << width << "\n" << "Height " << height << "\n";
+
+	for (int y = 0; y < height; ++y)
+	{
+		row.clear();
+
+		for (int x = 0; x < width; ++x)
+		{
+			int value = TileGridGet(MapData, x % MapData.width, y % MapData.height);
+
+			if (value == TYPE_OBJECT_HERO && (x >= MapData.width || y >= MapData.height))
+				value = TYPE_OBJECT_EMPTY;
+
+			row += (char)('0' + value);
+			row += ' ';
+		}
+
+		row.back() = '\n';
+		stream << row;
+	}
+
+	FreeMapData();
+
+	return stream.good();
+}
+
+/******************************************************************************/
+/*!
+	Plays the loaded level for a number of frames with the scripted input,
+	starting it again when it is lost or cleared. pStart, if given, runs
+	after every init. Returns the state checksum of the last frame, the
+	instances the level starts with, the time taken and the cache misses,
+	-1 if they could not be counted.
+*/
+/******************************************************************************/
+static u64 PlayLevel(unsigned int frameNum, unsigned int *pInstNum, double *pSeconds, long long *pCacheMisses,
+					 void (*pStart)(void) = 0)
+{
+	// particles are random, every run starts from the same seed
+	srand(1);
+	PlatformSimInit();
+
+	if (pStart)
+		pStart();
+
+	*pInstNum = gGameObjInstNum;
+
+	int counter = CacheMissStart();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		PlatformSimInput input;
+		ScriptedInput(frame, &input);
+
+		if (PlatformSimUpdate(input) != PLATFORM_SIM_RESULT_NONE)
+		{
+			PlatformSimFree();
+			PlatformSimInit();
+
+			if (pStart)
+				pStart();
+		}
+	}
+
+	std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+	*pCacheMisses	= CacheMissStop(counter);
+	*pSeconds		= seconds.count();
+
+	u64 hash = StateChecksum();
+
+	PlatformSimFree();
+
+	return hash;
+}
+
+/******************************************************************************/
+/*!
+	Plays a level made of tileNum x tileNum copies of Exported2.txt with
+	the fused instance update and with one pass per step. Both have to
+	end in the same state.
+*/
+/******************************************************************************/
+static int FusedBenchmark(int tileNum, unsigned int frameNum)
+{
+	const char	*LevelName	= "FusedLevel.txt";
+	const char	*Path[]		= { "multi-pass", "fused" };
+	u64			hash[2];
+	double		seconds[2];
+	long long	misses[2];
+	unsigned int	instNum;
+
+	if (!WriteTiledLevel("../Resources/Levels/Exported2.txt", LevelName, tileNum))
+	{
+		PRINT("Could not write %s\n", LevelName);
+		return 1;
+	}
+
+	for (int fused = 0; fused < 2; ++fused)
+	{
+		PlatformSimSetOption(PLATFORM_SIM_OPTION_FUSED_UPDATE, fused != 0);
+
+		if (!PlatformSimLoad(LevelName))
+		{
+			PRINT("Could not load level %s\n", LevelName);
+			PlatformSimUnload();
+			remove(LevelName);
+			return 1;
+		}
+
+		hash[fused] = PlayLevel(frameNum, &instNum, seconds + fused, misses + fused);
+
+		if (0 == fused)
+			PRINT("Level:       Exported2.txt %d x %d times, %d x %d, %u instances\n", tileNum, tileNum,
+				BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT, instNum);
+
+		PlatformSimUnload();
+	}
+
+	PlatformSimSetOption(PLATFORM_SIM_OPTION_FUSED_UPDATE, true);
+	remove(LevelName);
+
+	for (int fused = 0; fused < 2; ++fused)
+	{
+		PRINT("%-12s %.3f ms per frame, ", (std::string(Path[fused]) + ":").c_str(), seconds[fused] * 1000.0 / frameNum);
+
+		if (misses[fused] >= 0)
+			PRINT("%.1f cache misses per frame\n", (double)misses[fused] / frameNum);
+		else
+			PRINT("cache misses n/a\n");
+	}
+
+	PRINT("Checksums:   %016llx %016llx, %s\n", (unsigned long long)hash[0], (unsigned long long)hash[1],
+		hash[0] == hash[1] ? "identical" : "DIFFER");
+
+	return hash[0] == hash[1] ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Puts every coin back into the update passes
+*/
+/******************************************************************************/
+static void WakeCoins(void)
+{
+	for (unsigned int i = 0; i < gGameObjInstNum; ++i)
+		if (TYPE_OBJECT_COIN == gameObjInst(gGameObjInstLiveList[i])->pObject->type)
+			gameObjInstWake(gGameObjInstLiveList[i]);
+}
+
+/******************************************************************************/
+/*!
+	Plays a level made of tileNum x tileNum copies of Exported2.txt with
+	coins that are updated every frame, with coins that sleep from the
+	moment they spawn, and with sleeping coins that are woken again right
+	after. All three have to end in the same state.
+*/
+/******************************************************************************/
+static int CoinBenchmark(int tileNum, unsigned int frameNum)
+{
+	const char	*LevelName	= "CoinLevel.txt";
+	const char	*Path[]		= { "awake", "sleeping", "woken" };
+	u64			hash[3];
+	double		seconds[3];
+	long long	misses[3];
+	unsigned int	instNum;
+
+	if (!WriteTiledLevel("../Resources/Levels/Exported2.txt", LevelName, tileNum))
+	{
+		PRINT("Could not write %s\n", LevelName);
+		return 1;
+	}
+
+	for (int path = 0; path < 3; ++path)
+	{
+		PlatformSimSetOption(PLATFORM_SIM_OPTION_SLEEPING_COINS, path != 0);
+
+		if (!PlatformSimLoad(LevelName))
+		{
+			PRINT("Could not load level %s\n", LevelName);
+			PlatformSimUnload();
+			remove(LevelName);
+			return 1;
+		}
+
+		hash[path] = PlayLevel(frameNum, &instNum, seconds + path, misses + path, 2 == path ? WakeCoins : 0);
+
+		if (0 == path)
+			PRINT("Level:       Exported2.txt %d x %d times, %d x %d, %u instances\n", tileNum, tileNum,
+				BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT, instNum);
+
+		PlatformSimUnload();
+	}
+
+	PlatformSimSetOption(PLATFORM_SIM_OPTION_SLEEPING_COINS, true);
+	remove(LevelName);
+
+	for (int path = 0; path < 3; ++path)
+	{
+		PRINT("%-12s %.3f ms per frame, ", (std::string(Path[path]) + ":").c_str(), seconds[path] * 1000.0 / frameNum);
+
+		if (misses[path] >= 0)
+			PRINT("%.1f cache misses per frame\n", (double)misses[path] / frameNum);
+		else
+			PRINT("cache misses n/a\n");
+	}
+
+	bool identical = hash[0] == hash[1] && hash[0] == hash[2];
+
+	PRINT("Checksums:   %016llx %016llx %016llx, %s\n", (unsigned long long)hash[0], (unsigned long long)hash[1],
+		(unsigned long long)hash[2], identical ? "identical" : "DIFFER");
+
+	return identical ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Writes a text level of corridors, one cell high and 1000 cells long.
+	Enemies fill the odd cells of the corridors and coins the even ones
+	until there are enemyNum and coinNum of them. The hero has the lowest
+	corridor to itself.
+*/
+/******************************************************************************/
+static bool WriteCrowdLevel(const char *FileName, unsigned int enemyNum, unsigned int coinNum)
+{
+	const int		CorridorLength	= 1000;
+	unsigned int	pairNum			= (std::max)(enemyNum, coinNum);
+	int				corridorNum		= (int)((pairNum + CorridorLength / 2 - 1) / (CorridorLength / 2)) + 1;
+	int				width			= CorridorLength + 2;
+	int				height			= corridorNum * 2 + 1;
+	std::ofstream	stream{ FileName, std::ios::trunc };
+	std::string		row;
+
+	stream << "Width " << width << "\n" << "Height " << height << "\n";
+
+	for (int y = 0; y < height; ++y)
+	{
+		row.clear();
+
+		for (int x = 0; x < width; ++x)
+		{
+			int value = TYPE_OBJECT_COLLISION;
+
+			if ((y & 1) && x > 0 && x < width - 1)
+			{
+				// cells of each kind before this one
+				unsigned int index = (unsigned int)((y / 2 - 1) * (CorridorLength / 2) + (x - 1) / 2);
+
+				if (1 == y)
+					value = 1 == x ? TYPE_OBJECT_HERO : TYPE_OBJECT_EMPTY;
+				else if (x & 1)
+					value = index < enemyNum ? TYPE_OBJECT_ENEMY1 : TYPE_OBJECT_EMPTY;
+				else
+					value = index < coinNum ? TYPE_OBJECT_COIN : TYPE_OBJECT_EMPTY;
+			}
+
+			row += (char)('0' + value);
+			row += ' ';
+		}
+
+		row.back() = '\n';
+		stream << row;
+	}
+
+	return stream.good();
+}
+
+/******************************************************************************/
+/*!
+	Plays frames of the loaded level and times each of them. Before every
+	frame destroyNum coins are destroyed, from the end of the live list.
+*/
+/******************************************************************************/
+static void TimePoolFrames(unsigned int firstFrame, unsigned int frameNum, unsigned int destroyNum, double *pAverage, double *pMin, double *pMax)
+{
+	double total = 0.0;
+
+	*pMin = 1e9;
+	*pMax = 0.0;
+
+	for (unsigned int frame = firstFrame; frame < firstFrame + frameNum; ++frame)
+	{
+		PlatformSimInput input;
+		ScriptedInput(frame, &input);
+
+		for (unsigned int destroy = 0; destroy < destroyNum; ++destroy)
+			for (unsigned int i = gGameObjInstNum; i > 0; --i)
+				if (TYPE_OBJECT_COIN == gameObjInst(gGameObjInstLiveList[i - 1])->pObject->type)
+				{
+					gameObjInstDestroy(gGameObjInstLiveList[i - 1]);
+					break;
+				}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		if (PlatformSimUpdate(input) != PLATFORM_SIM_RESULT_NONE)
+		{
+			PlatformSimFree();
+			PlatformSimInit();
+		}
+
+		std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+		total	+= seconds.count();
+		*pMin	= (std::min)(*pMin, seconds.count());
+		*pMax	= (std::max)(*pMax, seconds.count());
+	}
+
+	*pAverage = total / frameNum;
+}
+
+/******************************************************************************/
+/*!
+	Fills the instance pool with a generated level of about instNum
+	enemies and coins. Reports what the pool costs in memory, how long it
+	takes to spawn them all and the time of a frame, then the time of a
+	frame while destroyNum coins are destroyed before each one.
+*/
+/******************************************************************************/
+static int PoolBenchmark(unsigned int instNum, unsigned int frameNum, unsigned int destroyNum)
+{
+	const char *LevelName = "PoolLevel.txt";
+
+	if (!WriteCrowdLevel(LevelName, (instNum + 1) / 2, (instNum + 1) / 2))
+	{
+		PRINT("Could not write %s\n", LevelName);
+		return 1;
+	}
+
+	if (!PlatformSimLoad(LevelName))
+	{
+		PRINT("Could not load level %s\n", LevelName);
+		PlatformSimUnload();
+		remove(LevelName);
+		return 1;
+	}
+
+	remove(LevelName);
+	srand(1);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	PlatformSimInit();
+
+	std::chrono::duration<double> initSeconds = std::chrono::steady_clock::now() - start;
+
+	unsigned int	spawnNum	= gGameObjInstNum;
+	size_t			memory		= gameObjInstPoolMemory();
+	size_t			slotBytes	= sizeof(GameObjInstChunk) / GAME_OBJ_INST_CHUNK_SIZE;
+	double			frameAverage, frameMin, frameMax, destroyAverage, destroyMin, destroyMax;
+
+	TimePoolFrames(0,			frameNum, 0,			&frameAverage,		&frameMin,		&frameMax);
+	TimePoolFrames(frameNum,	frameNum, destroyNum,	&destroyAverage,	&destroyMin,	&destroyMax);
+
+	PRINT("Level:       %d x %d, %u instances in %u chunks of %u\n", BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT,
+		spawnNum, (spawnNum + GAME_OBJ_INST_CHUNK_MASK) >> GAME_OBJ_INST_CHUNK_SHIFT, GAME_OBJ_INST_CHUNK_SIZE);
+	PRINT("Pool:        %.1f MB, %.1f bytes per instance, %u bytes of them in the chunk fields\n",
+		memory / (1024.0 * 1024.0), (double)memory / spawnNum, (unsigned int)slotBytes);
+	PRINT("Overhead:    %.1f bytes per instance, %.1f%% over the fields of the live instances\n",
+		(double)(memory - spawnNum * slotBytes) / spawnNum, 100.0 * (memory - spawnNum * slotBytes) / (spawnNum * slotBytes));
+	PRINT("Spawn:       %.1f ms for every instance, %.1f ns each\n", initSeconds.count() * 1000.0, initSeconds.count() * 1e9 / spawnNum);
+	PRINT("Frames:      %.2f ms on average, %.2f to %.2f ms over %u frames\n",
+		frameAverage * 1000.0, frameMin * 1000.0, frameMax * 1000.0, frameNum);
+	PRINT("Destroys:    %.2f ms on average, %.2f to %.2f ms with %u coins destroyed before each frame\n",
+		destroyAverage * 1000.0, destroyMin * 1000.0, destroyMax * 1000.0, destroyNum);
+
+	PlatformSimFree();
+	PlatformSimUnload();
+
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	Moves boxes around a 256 x 256 tile world and finds their pairs with
+	the grid every frame. The first frame is checked against testing every
+	box with every other box.
+*/
+/******************************************************************************/
+static int BroadphaseBenchmark(unsigned int boxNum, unsigned int frameNum)
+{
+	const int		WORLD_SIZE	= 256;
+	Broadphase		broadphase;
+	std::vector<AABB>	box(boxNum);
+	std::vector<AEVec2>	vel(boxNum);
+	unsigned int	pairTotal	= 0;
+
+	srand(1);
+	for (unsigned int i = 0; i < boxNum; ++i)
+	{
+		f32 size	= BOUNDING_RECT_SIZE * (0.5f + 0.5f * rand() / RAND_MAX);
+		f32 x		= (WORLD_SIZE - size) * rand() / RAND_MAX;
+		f32 y		= (WORLD_SIZE - size) * rand() / RAND_MAX;
+
+		AEVec2Set(&box[i].min, x, y);
+		AEVec2Set(&box[i].max, x + size, y + size);
+		AEVec2Set(&vel[i],	MOVE_VELOCITY_ENEMY * (2.f * rand() / RAND_MAX - 1.f),
+							MOVE_VELOCITY_ENEMY * (2.f * rand() / RAND_MAX - 1.f));
+	}
+
+	if (!BroadphaseInit(&broadphase, 1.f, WORLD_SIZE, WORLD_SIZE))
+		return 1;
+
+	/*CHECK THE FIRST FRAME*/
+	unsigned int bruteNum = 0;
+	for (unsigned int i = 0; i < boxNum; ++i)
+		for (unsigned int j = i + 1; j < boxNum; ++j)
+			if (!(box[i].min.x > box[j].max.x || box[i].max.x < box[j].min.x ||
+				  box[i].min.y > box[j].max.y || box[i].max.y < box[j].min.y))
+				++bruteNum;
+
+	for (unsigned int i = 0; i < boxNum; ++i)
+		BroadphaseAdd(&broadphase, i, box[i]);
+
+	unsigned int gridNum = BroadphaseFindPairs(&broadphase);
+
+	PRINT("Pairs:       %u grid, %u every box with every box\n", gridNum, bruteNum);
+
+	/*MOVE AND FIND PAIRS*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		BroadphaseClear(&broadphase);
+
+		for (unsigned int i = 0; i < boxNum; ++i)
+		{
+			// bounce off the world edges
+			if ((box[i].min.x < 0.f && vel[i].x < 0.f) || (box[i].max.x > WORLD_SIZE && vel[i].x > 0.f))
+				vel[i].x = -vel[i].x;
+			if ((box[i].min.y < 0.f && vel[i].y < 0.f) || (box[i].max.y > WORLD_SIZE && vel[i].y > 0.f))
+				vel[i].y = -vel[i].y;
+
+			box[i].min.x += vel[i].x * g_dt;
+			box[i].min.y += vel[i].y * g_dt;
+			box[i].max.x += vel[i].x * g_dt;
+			box[i].max.y += vel[i].y * g_dt;
+
+			BroadphaseAdd(&broadphase, i, box[i]);
+		}
+
+		pairTotal += BroadphaseFindPairs(&broadphase);
+	}
+
+	std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+	PRINT("Boxes:       %u in %d x %d cells\n", boxNum, WORLD_SIZE, WORLD_SIZE);
+	PRINT("Frames:      %u (%.1f pairs per frame)\n", frameNum, (double)pairTotal / frameNum);
+	PRINT("Frame time:  %.3f ms\n", seconds.count() * 1000.0 / frameNum);
+
+	BroadphaseFree(&broadphase);
+
+	return gridNum == bruteNum ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Random coordinate on a quarter unit grid most of the time, so that
+	touching edges and equal velocities come up often
+*/
+/******************************************************************************/
+static f32 RandomCoordinate(f32 range)
+{
+	f32 value = range * (2.f * rand() / RAND_MAX - 1.f);
+
+	return rand() % 4 ? (f32)(int)(value * 4.f) / 4.f : value;
+}
+
+/******************************************************************************/
+/*!
+	Tests random boxes against batches of random boxes with the SIMD batch
+	and with the scalar test, the two must agree on every box.
+	Then times both.
+*/
+/******************************************************************************/
+static int RectBatchBenchmark(unsigned int boxNum, unsigned int roundNum)
+{
+	std::vector<f32>			component(6 * boxNum);
+	std::vector<unsigned int>	hitMask((boxNum + 31) / 32);
+	std::vector<AABB>			box(roundNum);
+	std::vector<AEVec2>			vel(roundNum);
+	unsigned int				mismatchNum = 0, batchHitNum = 0, scalarHitNum = 0;
+
+	AABBBatch batch;
+	batch.pMinX	= &component[0];
+	batch.pMinY	= batch.pMinX + boxNum;
+	batch.pMaxX	= batch.pMinY + boxNum;
+	batch.pMaxY	= batch.pMaxX + boxNum;
+	batch.pVelX	= batch.pMaxY + boxNum;
+	batch.pVelY	= batch.pVelX + boxNum;
+	batch.num	= boxNum;
+
+	srand(1);
+	for (unsigned int i = 0; i < boxNum; ++i)
+	{
+		f32 x = RandomCoordinate(8.f), y = RandomCoordinate(8.f);
+
+		component[i]				= x;
+		component[boxNum + i]		= y;
+		component[2 * boxNum + i]	= x + AEMax(0.f, RandomCoordinate(2.f));
+		component[3 * boxNum + i]	= y + AEMax(0.f, RandomCoordinate(2.f));
+		component[4 * boxNum + i]	= rand() % 3 ? RandomCoordinate(MOVE_VELOCITY_ENEMY) : 0.f;
+		component[5 * boxNum + i]	= rand() % 3 ? RandomCoordinate(JUMP_VELOCITY) : 0.f;
+	}
+
+	for (unsigned int k = 0; k < roundNum; ++k)
+	{
+		f32 x = RandomCoordinate(8.f), y = RandomCoordinate(8.f);
+
+		AEVec2Set(&box[k].min, x, y);
+		AEVec2Set(&box[k].max, x + AEMax(0.f, RandomCoordinate(2.f)), y + AEMax(0.f, RandomCoordinate(2.f)));
+		AEVec2Set(&vel[k],	rand() % 3 ? RandomCoordinate(MOVE_VELOCITY_HERO) : 0.f,
+							rand() % 3 ? RandomCoordinate(JUMP_VELOCITY) : 0.f);
+	}
+
+	/*COMPARE WITH THE SCALAR TEST*/
+	for (unsigned int k = 0; k < roundNum; ++k)
+	{
+		CollisionIntersection_RectRectBatch(box[k], vel[k], batch, &hitMask[0]);
+
+		for (unsigned int i = 0; i < boxNum; ++i)
+		{
+			AABB	aabb2;
+			AEVec2	vel2;
+
+			AEVec2Set(&aabb2.min,	batch.pMinX[i], batch.pMinY[i]);
+			AEVec2Set(&aabb2.max,	batch.pMaxX[i], batch.pMaxY[i]);
+			AEVec2Set(&vel2,		batch.pVelX[i], batch.pVelY[i]);
+
+			bool hit = CollisionIntersection_RectRect(box[k], vel[k], aabb2, vel2);
+
+			if (hit != (0 != (hitMask[i / 32] >> (i % 32) & 1)))
+				++mismatchNum;
+		}
+	}
+
+	/*TIME BOTH*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int k = 0; k < roundNum; ++k)
+		batchHitNum += CollisionIntersection_RectRectBatch(box[k], vel[k], batch, &hitMask[0]);
+
+	std::chrono::duration<double> batchSeconds = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int k = 0; k < roundNum; ++k)
+		for (unsigned int i = 0; i < boxNum; ++i)
+		{
+			AABB	aabb2;
+			AEVec2	vel2;
+
+			AEVec2Set(&aabb2.min,	batch.pMinX[i], batch.pMinY[i]);
+			AEVec2Set(&aabb2.max,	batch.pMaxX[i], batch.pMaxY[i]);
+			AEVec2Set(&vel2,		batch.pVelX[i], batch.pVelY[i]);
+
+			scalarHitNum += CollisionIntersection_RectRect(box[k], vel[k], aabb2, vel2);
+		}
+
+	std::chrono::duration<double> scalarSeconds = std::chrono::steady_clock::now() - start;
+
+	PRINT("Tests:       %u boxes x %u rounds, %u hits, %u mismatches\n", boxNum, roundNum, batchHitNum, mismatchNum);
+	PRINT("Batch:       %.2f ns per box\n", batchSeconds.count() * 1e9 / ((double)boxNum * roundNum));
+	PRINT("Scalar:      %.2f ns per box\n", scalarSeconds.count() * 1e9 / ((double)boxNum * roundNum));
+
+	return mismatchNum || batchHitNum != scalarHitNum ? 1 : 0;
+}
+
+/******************************************************************************/
+/*!
+	Sweeps a moving box against boxes packed around it, most of which it
+	touches during the frame, and times the frame three ways: the SIMD
+	batch that only tells hits, the swept batch that sorts the hits by
+	time, and the contact queue fed by the swept test and sorted by time.
+	The two sorted results must hold the same hits in the same order.
+*/
+/******************************************************************************/
+static int ContactBenchmark(unsigned int boxNum, unsigned int frameNum)
+{
+	std::vector<f32>			component(6 * boxNum);
+	std::vector<unsigned int>	hitMask((boxNum + 31) / 32);
+	std::vector<RectRectHit>	hit(boxNum);
+	unsigned int				maskHitNum = 0, sweptHitNum = 0, queueHitNum = 0, misorderNum = 0;
+	ContactQueue				queue;
+	AABB						box;
+	AEVec2						vel;
+
+	AABBBatch batch;
+	batch.pMinX	= &component[0];
+	batch.pMinY	= batch.pMinX + boxNum;
+	batch.pMaxX	= batch.pMinY + boxNum;
+	batch.pMaxY	= batch.pMaxX + boxNum;
+	batch.pVelX	= batch.pMaxY + boxNum;
+	batch.pVelY	= batch.pVelX + boxNum;
+	batch.num	= boxNum;
+
+	// boxes the size of a tile, up to a quarter of a tile away from the hero box
+	srand(1);
+	AEVec2Set(&box.min, -BOUNDING_RECT_SIZE / 2.f, -BOUNDING_RECT_SIZE / 2.f);
+	AEVec2Set(&box.max, BOUNDING_RECT_SIZE / 2.f, BOUNDING_RECT_SIZE / 2.f);
+	AEVec2Set(&vel, MOVE_VELOCITY_HERO, JUMP_VELOCITY / 2.f);
+
+	for (unsigned int i = 0; i < boxNum; ++i)
+	{
+		f32 x = 2.5f * rand() / RAND_MAX - 1.75f, y = 2.5f * rand() / RAND_MAX - 1.75f;
+
+		component[i]				= x;
+		component[boxNum + i]		= y;
+		component[2 * boxNum + i]	= x + BOUNDING_RECT_SIZE;
+		component[3 * boxNum + i]	= y + BOUNDING_RECT_SIZE;
+		component[4 * boxNum + i]	= RandomCoordinate(MOVE_VELOCITY_ENEMY * 4.f);
+		component[5 * boxNum + i]	= RandomCoordinate(JUMP_VELOCITY);
+	}
+
+	if (!ContactQueueInit(&queue))
+		return 1;
+
+	/*HITS ONLY*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+		maskHitNum = CollisionIntersection_RectRectBatch(box, vel, batch, &hitMask[0]);
+
+	std::chrono::duration<double> maskSeconds = std::chrono::steady_clock::now() - start;
+
+	/*SWEPT BATCH, SORTED BY TIME*/
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+		sweptHitNum = CollisionIntersection_RectRectSweptBatch(box, vel, batch, &hit[0]);
+
+	std::chrono::duration<double> sweptSeconds = std::chrono::steady_clock::now() - start;
+
+	/*CONTACT QUEUE, SORTED BY TIME*/
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		if (!ContactQueueBegin(&queue, boxNum))
+			return 1;
+
+		for (unsigned int i = 0; i < boxNum; ++i)
+		{
+			AABB			aabb2;
+			AEVec2			vel2;
+			RectRectContact	contact;
+
+			AEVec2Set(&aabb2.min,	batch.pMinX[i], batch.pMinY[i]);
+			AEVec2Set(&aabb2.max,	batch.pMaxX[i], batch.pMaxY[i]);
+			AEVec2Set(&vel2,		batch.pVelX[i], batch.pVelY[i]);
+
+			if (CollisionIntersection_RectRectSwept(box, vel, aabb2, vel2, &contact))
+				ContactQueueWrite(&queue, i, 0, i, contact.tFirst, contact.normal);
+		}
+
+		ContactQueueEnd			(&queue);
+		ContactQueueSortByTime	(&queue);
+		queueHitNum = queue.touchNum;
+	}
+
+	std::chrono::duration<double> queueSeconds = std::chrono::steady_clock::now() - start;
+
+	for (unsigned int i = 0; i < sweptHitNum && i < queueHitNum; ++i)
+		if (hit[i].index != queue.pEvent[i].b ||
+			(i > 0 && hit[i].contact.tFirst < hit[i - 1].contact.tFirst))
+			++misorderNum;
+
+	PRINT("Contacts:    %u boxes, %u already overlap, %u touch during the frame, %u misordered\n",
+		boxNum, maskHitNum, sweptHitNum, misorderNum);
+	PRINT("Hits only:   %.3f ms per frame\n", maskSeconds.count() * 1e3 / frameNum);
+	PRINT("Swept batch: %.3f ms per frame, %.2f ns per contact\n", sweptSeconds.count() * 1e3 / frameNum,
+		sweptSeconds.count() * 1e9 / ((double)frameNum * (sweptHitNum ? sweptHitNum : 1)));
+	PRINT("Queue:       %.3f ms per frame, %.2f ns per contact\n", queueSeconds.count() * 1e3 / frameNum,
+		queueSeconds.count() * 1e9 / ((double)frameNum * (queueHitNum ? queueHitNum : 1)));
+
+	ContactQueueFree(&queue);
+
+	return misorderNum || sweptHitNum != queueHitNum ? 1 : 0;
+}
+
+/******************************************************************************/
+/*!
+	Returns true if the merged rectangles are sorted by min.y and every
+	cell is in exactly as many rectangles as it is a collision cell
+*/
+/******************************************************************************/
+static bool ColliderListExact(void)
+{
+	unsigned int cellNum = 0;
+
+	for (unsigned int r = 1; r < BinaryColliderList.num; ++r)
+		if (BinaryColliderList.pRect[r].min.y < BinaryColliderList.pRect[r - 1].min.y)
+			return false;
+
+	for (int y = 0; y < BINARY_MAP_HEIGHT; ++y)
+		for (int x = 0; x < BINARY_MAP_WIDTH; ++x)
+		{
+			int inside = 0;
+
+			for (unsigned int r = 0; r < BinaryColliderList.num; ++r)
+			{
+				AABB *pRect = BinaryColliderList.pRect + r;
+
+				inside += pRect->min.x <= x && x < pRect->max.x && pRect->min.y <= y && y < pRect->max.y;
+			}
+
+			if (inside != GetCellValue(x, y))
+				return false;
+
+			cellNum += inside;
+		}
+
+	return cellNum == BinaryColliderList.cellNum;
+}
+
+/******************************************************************************/
+/*!
+	Loads a level, checks that its merged rectangles cover exactly the
+	collision cells, then sweeps random boxes through the level against
+	the rectangles and against the cells. Both must stop at the same time.
+	Last, random cells are changed one at a time and the rectangles are
+	checked again, against the map and against a new build.
+*/
+/******************************************************************************/
+static int ColliderBenchmark(const char *FileName, unsigned int sweepNum)
+{
+	std::vector<AABB>	box(sweepNum);
+	std::vector<AEVec2>	delta(sweepNum);
+	unsigned int		mismatchNum = 0;
+	f32					listSum = 0.f, mapSum = 0.f;
+	AEVec2				normal;
+
+	if (!PlatformSimLoad(FileName))
+	{
+		PRINT("Could not load level %s\n", FileName);
+		PlatformSimUnload();
+		return 1;
+	}
+
+	/*COVERAGE*/
+	bool exact = ColliderListExact();
+
+	srand(1);
+	for (unsigned int i = 0; i < sweepNum; ++i)
+	{
+		f32 x = (f32)BINARY_MAP_WIDTH * rand() / RAND_MAX, y = (f32)BINARY_MAP_HEIGHT * rand() / RAND_MAX;
+
+		AEVec2Set(&box[i].min, x - BOUNDING_RECT_SIZE / 2.f, y - BOUNDING_RECT_SIZE / 2.f);
+		AEVec2Set(&box[i].max, x + BOUNDING_RECT_SIZE / 2.f, y + BOUNDING_RECT_SIZE / 2.f);
+		AEVec2Set(&delta[i], RandomCoordinate(8.f), RandomCoordinate(8.f));
+	}
+
+	/*COMPARE WITH THE CELL SWEEP*/
+	for (unsigned int i = 0; i < sweepNum; ++i)
+	{
+		AEVec2	listNormal;
+		f32		listToi = ColliderListSweep(BinaryColliderList, box[i], delta[i], &listNormal);
+		f32		mapToi	= CollisionMapSweep(BinaryCollisionMap, box[i], delta[i], &normal);
+
+		// a box starting inside a collision cell sees the cells it leaves, the rectangle it is in is skipped
+		if (ColliderListOverlap(BinaryColliderList, box[i]))
+			continue;
+
+		if (fabsf(listToi - mapToi) > 1e-4f)
+			++mismatchNum;
+	}
+
+	/*TIME BOTH*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < sweepNum; ++i)
+		listSum += ColliderListSweep(BinaryColliderList, box[i], delta[i], &normal);
+
+	std::chrono::duration<double> listSeconds = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < sweepNum; ++i)
+		mapSum += CollisionMapSweep(BinaryCollisionMap, box[i], delta[i], &normal);
+
+	std::chrono::duration<double> mapSeconds = std::chrono::steady_clock::now() - start;
+
+	PRINT("Level:       %s, %d x %d\n", FileName, BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT);
+	PRINT("Colliders:   %u collision cells in %u rectangles, %.1f cells per rectangle, %s\n",
+		BinaryColliderList.cellNum, BinaryColliderList.num,
+		(double)BinaryColliderList.cellNum / (BinaryColliderList.num ? BinaryColliderList.num : 1),
+		exact ? "exact cover" : "WRONG COVER");
+	PRINT("Sweeps:      %u boxes up to 8 tiles, %u disagree, time of impact sums %.1f %.1f\n", sweepNum, mismatchNum, listSum, mapSum);
+	PRINT("Rectangles:  %.2f ns per sweep\n", listSeconds.count() * 1e9 / sweepNum);
+	PRINT("Cells:       %.2f ns per sweep\n", mapSeconds.count() * 1e9 / sweepNum);
+
+	/*CELL CHANGES*/
+	// inside cells flip between empty and collision, the edge of the map stays a wall
+	const unsigned int	changeNum = 1000;
+	std::vector<int>	cellX(changeNum), cellY(changeNum);
+
+	for (unsigned int i = 0; i < changeNum; ++i)
+	{
+		cellX[i] = 1 + rand() % (BINARY_MAP_WIDTH - 2);
+		cellY[i] = 1 + rand() % (BINARY_MAP_HEIGHT - 2);
+	}
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < changeNum; ++i)
+		SetCellValue(cellX[i], cellY[i], GetCellValue(cellX[i], cellY[i]) ? TYPE_OBJECT_EMPTY : TYPE_OBJECT_COLLISION);
+
+	std::chrono::duration<double> changeSeconds = std::chrono::steady_clock::now() - start;
+
+	bool			changedExact	= ColliderListExact();
+	unsigned int	changedNum		= BinaryColliderList.num;
+	ColliderList	list;
+
+	memset(&list, 0, sizeof(ColliderList));
+	start = std::chrono::steady_clock::now();
+
+	bool built = ColliderListBuild(&list, BinaryCollisionMap);
+
+	std::chrono::duration<double> buildSeconds = std::chrono::steady_clock::now() - start;
+
+	built = built && list.cellNum == BinaryColliderList.cellNum;
+
+	PRINT("Changes:     %u cells, %u rectangles after them (%u in a new build), %s\n", changeNum, changedNum, list.num,
+		changedExact && built ? "exact cover" : "WRONG COVER");
+	PRINT("Change:      %.2f us per cell, a new build takes %.2f us\n", changeSeconds.count() * 1e6 / changeNum,
+		buildSeconds.count() * 1e6);
+
+	ColliderListFree(&list);
+	PlatformSimUnload();
+
+	return exact && changedExact && built && 0 == mismatchNum ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Loads a level and casts random rays across it as one batch, then tests
+	random boxes against it. A sample of both is checked against walking
+	the cells by hand.
+*/
+/******************************************************************************/
+static int RayBenchmark(const char *FileName, unsigned int rayNum)
+{
+	std::vector<MapRay>			ray(rayNum);
+	std::vector<MapRayHit>		hit(rayNum);
+	std::vector<AABB>			box(rayNum);
+	std::vector<unsigned int>	hitMask((rayNum + 31) / 32);
+	unsigned int				rayHitNum = 0, mismatchNum = 0, checkNum = AEMin(2000.f, (f32)rayNum);
+
+	if (!PlatformSimLoad(FileName))
+	{
+		PRINT("Could not load level %s\n", FileName);
+		PlatformSimUnload();
+		return 1;
+	}
+
+	f32 diagonal = sqrtf((f32)(BINARY_MAP_WIDTH * BINARY_MAP_WIDTH + BINARY_MAP_HEIGHT * BINARY_MAP_HEIGHT));
+
+	srand(1);
+	for (unsigned int i = 0; i < rayNum; ++i)
+	{
+		f32 angle	= TWO_PI * rand() / RAND_MAX;
+		f32 x		= (f32)BINARY_MAP_WIDTH * rand() / RAND_MAX;
+		f32 y		= (f32)BINARY_MAP_HEIGHT * rand() / RAND_MAX;
+
+		AEVec2Set(&ray[i].origin, x, y);
+		AEVec2Set(&ray[i].dir, cosf(angle), sinf(angle));
+		ray[i].maxT = diagonal;
+
+		// boxes up to a few tiles, one in eight up to wider than a bit map word
+		f32 w = (rand() % 8 ? 3.f : 40.f) * rand() / RAND_MAX, h = 2.f * rand() / RAND_MAX;
+		AEVec2Set(&box[i].min, x - w / 2.f, y - h / 2.f);
+		AEVec2Set(&box[i].max, x + w / 2.f, y + h / 2.f);
+	}
+
+	/*RAYS*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	MapQueryRaycastBatch(BinaryCollisionMap, &ray[0], rayNum, &hit[0]);
+
+	std::chrono::duration<double> raySeconds = std::chrono::steady_clock::now() - start;
+
+	for (unsigned int i = 0; i < rayNum; ++i)
+		rayHitNum += hit[i].hit;
+
+	/*BOXES*/
+	start = std::chrono::steady_clock::now();
+
+	unsigned int boxHitNum = MapQueryBoxOverlapBatch(BinaryCollisionMap, &box[0], rayNum, &hitMask[0]);
+
+	std::chrono::duration<double> boxSeconds = std::chrono::steady_clock::now() - start;
+
+	/*CHECK A SAMPLE BY HAND*/
+	for (unsigned int i = 0; i < checkNum; ++i)
+	{
+		// the first collision cell a fine march along the ray lands in
+		int cellX = 0, cellY = 0;
+		bool marchHit = false;
+
+		for (f32 t = 0.f; t <= ray[i].maxT && !marchHit; t += 1e-3f)
+		{
+			cellX		= (int)floorf(ray[i].origin.x + ray[i].dir.x * t);
+			cellY		= (int)floorf(ray[i].origin.y + ray[i].dir.y * t);
+			marchHit	= 0 != GetCellValue(cellX, cellY);
+		}
+
+		if (marchHit != hit[i].hit || (marchHit && (cellX != hit[i].cellX || cellY != hit[i].cellY)))
+			++mismatchNum;
+
+		bool overlap = false;
+
+		for (int y = (int)floorf(box[i].min.y); y < (int)ceilf(box[i].max.y); ++y)
+			for (int x = (int)floorf(box[i].min.x); x < (int)ceilf(box[i].max.x); ++x)
+				overlap = overlap || GetCellValue(x, y);
+
+		if (overlap != (0 != (hitMask[i / 32] >> (i % 32) & 1)))
+			++mismatchNum;
+	}
+
+	PRINT("Level:       %s, %d x %d\n", FileName, BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT);
+	PRINT("Rays:        %u, %u hit, %.1f million rays per second, %.2f ns per ray\n", rayNum, rayHitNum,
+		rayNum / raySeconds.count() / 1e6, raySeconds.count() * 1e9 / rayNum);
+	PRINT("Boxes:       %u, %u overlap, %.2f ns per box\n", rayNum, boxHitNum, boxSeconds.count() * 1e9 / rayNum);
+	PRINT("Checked:     %u rays and boxes by hand, %u disagree\n", checkNum, mismatchNum);
+
+	PlatformSimUnload();
+
+	return mismatchNum ? 1 : 0;
+}
+
+/******************************************************************************/
+/*!
+	GetCellValue on the int ** collision map the game used before the
+	bit-packed one, a column array per x
+*/
+/******************************************************************************/
+static int LegacyCellValue(int **ppMap, int width, int height, int X, int Y)
+{
+	if (0 <= X && X < width &&
+		0 <= Y && Y < height)
+	{
+		return ppMap[X][Y];
+	}
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	CheckInstanceBinaryMapCollision on the int ** collision map
+*/
+/******************************************************************************/
+static int LegacyMapCollision(int **ppMap, int width, int height, float PosX, float PosY, float scaleX, float scaleY)
+{
+	int flag = 0;
+
+	if (LegacyCellValue(ppMap, width, height, (int)(PosX + scaleX / 2.f), (int)(PosY + scaleY / 4.f)) ||
+		LegacyCellValue(ppMap, width, height, (int)(PosX + scaleX / 2.f), (int)(PosY - scaleY / 4.f)))
+		flag |= COLLISION_RIGHT;
+
+	if (LegacyCellValue(ppMap, width, height, (int)(PosX - scaleX / 2.f), (int)(PosY + scaleY / 4.f)) ||
+		LegacyCellValue(ppMap, width, height, (int)(PosX - scaleX / 2.f), (int)(PosY - scaleY / 4.f)))
+		flag |= COLLISION_LEFT;
+
+	if (LegacyCellValue(ppMap, width, height, (int)(PosX + scaleX / 4.f), (int)(PosY + scaleY / 2.f)) ||
+		LegacyCellValue(ppMap, width, height, (int)(PosX - scaleX / 4.f), (int)(PosY + scaleY / 2.f)))
+		flag |= COLLISION_TOP;
+
+	if (LegacyCellValue(ppMap, width, height, (int)(PosX + scaleX / 4.f), (int)(PosY - scaleY / 2.f)) ||
+		LegacyCellValue(ppMap, width, height, (int)(PosX - scaleX / 4.f), (int)(PosY - scaleY / 2.f)))
+		flag |= COLLISION_BOTTOM;
+
+	return flag;
+}
+
+/******************************************************************************/
+/*!
+	Fills a square map with random collision cells and runs the same
+	instance probes against the int ** map and the bit-packed map.
+	The flags must agree.
+*/
+/******************************************************************************/
+static int ProbeBenchmark(int size, unsigned int probeNum)
+{
+	std::vector<AEVec2>	pos(probeNum);
+	unsigned int		legacySum = 0, bitSum = 0;
+	int					**ppLegacy = new int* [size];
+
+	srand(1);
+	if (!CollisionMapInit(&BinaryCollisionMap, size, size))
+		return 1;
+
+	for (int x = 0; x < size; ++x)
+	{
+		ppLegacy[x] = new int[size];
+
+		for (int y = 0; y < size; ++y)
+		{
+			ppLegacy[x][y] = rand() % 10 < 3;
+			CollisionMapSet(&BinaryCollisionMap, x, y, ppLegacy[x][y]);
+		}
+	}
+
+	// probes also land just outside of the map
+	for (unsigned int i = 0; i < probeNum; ++i)
+		AEVec2Set(&pos[i], (size + 2.f) * rand() / RAND_MAX - 1.f, (size + 2.f) * rand() / RAND_MAX - 1.f);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < probeNum; ++i)
+		legacySum += LegacyMapCollision(ppLegacy, size, size, pos[i].x, pos[i].y, BOUNDING_RECT_SIZE, BOUNDING_RECT_SIZE) * (i + 1);
+
+	std::chrono::duration<double> legacySeconds = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < probeNum; ++i)
+		bitSum += CheckInstanceBinaryMapCollision(pos[i].x, pos[i].y, BOUNDING_RECT_SIZE, BOUNDING_RECT_SIZE) * (i + 1);
+
+	std::chrono::duration<double> bitSeconds = std::chrono::steady_clock::now() - start;
+
+	PRINT("Map:         %d x %d, int ** %.1f MB, bits %.1f MB\n", size, size,
+		((double)size * size * sizeof(int) + size * sizeof(int*)) / (1024.0 * 1024.0),
+		(double)BinaryCollisionMap.rowWords * size * sizeof(unsigned int) / (1024.0 * 1024.0));
+	PRINT("Probes:      %u instances, 8 cells each, flags %s\n", probeNum, legacySum == bitSum ? "match" : "DIFFER");
+	PRINT("int **:      %.2f ns per instance\n", legacySeconds.count() * 1e9 / probeNum);
+	PRINT("Bits:        %.2f ns per instance\n", bitSeconds.count() * 1e9 / probeNum);
+
+	for (int x = 0; x < size; ++x)
+		delete[] ppLegacy[x];
+	delete[] ppLegacy;
+	CollisionMapFree(&BinaryCollisionMap);
+
+	return legacySum == bitSum ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Fills a square map with random collision cells, then flips random cells
+	and updates the distance field after each one. The updated field must
+	match a field built from scratch.
+*/
+/******************************************************************************/
+static int DistanceBenchmark(int size, unsigned int changeNum)
+{
+	CollisionMap	map;
+	DistanceField	field, fresh;
+	size_t			cellNum = (size_t)size * size;
+
+	srand(1);
+	if (!CollisionMapInit(&map, size, size))
+		return 1;
+
+	// sparse walls so that the distances are not all 1
+	for (int y = 0; y < size; ++y)
+		for (int x = 0; x < size; ++x)
+			CollisionMapSet(&map, x, y, rand() % 100 < 2);
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if (!DistanceFieldInit(&field, map))
+		return 1;
+
+	std::chrono::duration<double> buildSeconds = std::chrono::steady_clock::now() - start;
+
+	unsigned int distanceMax = field.distanceMax;
+
+	start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < changeNum; ++i)
+	{
+		int x = rand() % size;
+		int y = rand() % size;
+
+		CollisionMapSet		(&map, x, y, !CollisionMapGet(map, x, y));
+		DistanceFieldUpdate	(&field, map, x, y);
+	}
+
+	std::chrono::duration<double> updateSeconds = std::chrono::steady_clock::now() - start;
+
+	if (!DistanceFieldInit(&fresh, map))
+		return 1;
+
+	bool match = 0 == memcmp(field.pDistance, fresh.pDistance, cellNum);
+
+	for (unsigned int i = 0; i < RUN_DIRECTION_NUM; ++i)
+		match = match && 0 == memcmp(field.pRun[i], fresh.pRun[i], cellNum);
+
+	PRINT("Map:         %d x %d, largest distance %u, tables %.1f MB\n", size, size, distanceMax,
+		(double)cellNum * (RUN_DIRECTION_NUM + 1) / (1024.0 * 1024.0));
+	PRINT("Build:       %.3f ms\n", buildSeconds.count() * 1e3);
+	PRINT("Update:      %u cell changes, %.2f us each, tables %s\n", changeNum,
+		updateSeconds.count() * 1e6 / (changeNum ? changeNum : 1), match ? "match" : "DIFFER");
+
+	DistanceFieldFree(&field);
+	DistanceFieldFree(&fresh);
+	CollisionMapFree(&map);
+
+	return match ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Reads a text level and writes it as a binary level file
+*/
+/******************************************************************************/
+static int ConvertLevel(const char *TextName, const char *BinaryName)
+{
+	int converted = ImportMapDataFromFile(TextName) && ExportMapDataToFile(BinaryName);
+
+	PRINT("%s (%d x %d) %s %s\n", TextName, BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT,
+		converted ? "written to" : "could not be written to", BinaryName);
+
+	FreeMapData();
+
+	return converted ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Writes a square text level: a wall around the edge, random walls,
+	enemies and coins inside, and a hero in the bottom left corner
+*/
+/******************************************************************************/
+static bool WriteTextLevel(const char *FileName, int size)
+{
+	std::ofstream	stream{ FileName, std::ios::trunc };
+	std::vector<char>	row((size_t)size * 2 + 1);
+
+	stream << "Width " << size << "\n" << "Height " << size << "\n";
+
+	srand(1);
+	for (int y = 0; y < size; ++y)
+	{
+		for (int x = 0; x < size; ++x)
+		{
+			int value	= rand() % 100;
+			value		= value < 10 ? TYPE_OBJECT_COLLISION : value == 10 ? TYPE_OBJECT_COIN : value == 11 && rand() % 8 == 0 ? TYPE_OBJECT_ENEMY1 : TYPE_OBJECT_EMPTY;
+
+			if (x == 0 || y == 0 || x == size - 1 || y == size - 1)
+				value = TYPE_OBJECT_COLLISION;
+			else if (x == 1 && y == 1)
+				value = TYPE_OBJECT_HERO;
+
+			row[x * 2]		= (char)('0' + value);
+			row[x * 2 + 1]	= ' ';
+		}
+
+		row[(size_t)size * 2] = '\n';
+		stream.write(row.data(), (std::streamsize)row.size());
+	}
+
+	return stream.good();
+}
+
+/******************************************************************************/
+/*!
+	Checksum of the imported map cells
+*/
+/******************************************************************************/
+static u64 MapChecksum(void)
+{
+	return Checksum(0xCBF29CE484222325ULL, MapData.pCells, (size_t)MapData.width * MapData.height);
+}
+
+/******************************************************************************/
+/*!
+	Writes a generated text level, converts it to a binary level file and
+	imports both. Both imports also build the collision map, the distance
+	field and the merged rectangles, which are timed on their own too.
+	The files are written just before they are read, so both are read from
+	the file cache.
+*/
+/******************************************************************************/
+static int LevelLoadBenchmark(int size, const char *BaseName)
+{
+	std::string	textName	= std::string(BaseName) + ".txt";
+	std::string	binaryName	= std::string(BaseName) + ".lvl";
+
+	if (!WriteTextLevel(textName.c_str(), size))
+	{
+		PRINT("Could not write %s\n", textName.c_str());
+		return 1;
+	}
+
+	/*CONVERT*/
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	int converted = ImportMapDataFromFile(textName.c_str()) && ExportMapDataToFile(binaryName.c_str());
+
+	std::chrono::duration<double> convertSeconds = std::chrono::steady_clock::now() - start;
+
+	FreeMapData();
+
+	if (!converted)
+	{
+		PRINT("Could not convert %s\n", textName.c_str());
+		remove(textName.c_str());
+		return 1;
+	}
+
+	/*TEXT IMPORT*/
+	start = std::chrono::steady_clock::now();
+
+	int textLoaded = ImportMapDataFromFile(textName.c_str());
+
+	std::chrono::duration<double> textSeconds = std::chrono::steady_clock::now() - start;
+
+	u64 textHash = textLoaded ? MapChecksum() : 0;
+
+	/*TABLES ALONE*/
+	DistanceField	field;
+	ColliderList	list;
+
+	memset(&list, 0, sizeof(ColliderList));
+	start = std::chrono::steady_clock::now();
+
+	bool tablesBuilt = DistanceFieldInit(&field, BinaryCollisionMap) && ColliderListBuild(&list, BinaryCollisionMap);
+
+	std::chrono::duration<double> tableSeconds = std::chrono::steady_clock::now() - start;
+
+	DistanceFieldFree(&field);
+	ColliderListFree(&list);
+	FreeMapData();
+
+	/*BINARY IMPORT*/
+	start = std::chrono::steady_clock::now();
+
+	int binaryLoaded = ImportMapDataFromFile(binaryName.c_str());
+
+	std::chrono::duration<double> binarySeconds = std::chrono::steady_clock::now() - start;
+
+	u64 binaryHash = binaryLoaded ? MapChecksum() : 0;
+
+	FreeMapData();
+
+	/*MAPPING ALONE*/
+	LevelFile	file;
+	u64			cellSum = 0;
+
+	start = std::chrono::steady_clock::now();
+
+	if (LevelFileOpen(&file, binaryName.c_str()))
+	{
+		// the open has checked every cell, the sum keeps the reads
+		for (size_t i = 0, num = (size_t)file.pHeader->width * file.pHeader->height; i < num; ++i)
+			cellSum += file.pCells[i];
+	}
+
+	std::chrono::duration<double> mapSeconds = std::chrono::steady_clock::now() - start;
+
+	unsigned int spawnNum = file.pHeader ? file.pHeader->spawnNum : 0;
+
+	LevelFileClose(&file);
+
+	std::ifstream	textStream{ textName, std::ios::binary | std::ios::ate };
+	std::ifstream	binaryStream{ binaryName, std::ios::binary | std::ios::ate };
+	double			textMB		= (double)textStream.tellg() / (1024.0 * 1024.0);
+	double			binaryMB	= (double)binaryStream.tellg() / (1024.0 * 1024.0);
+
+	textStream.close();
+	binaryStream.close();
+	remove(textName.c_str());
+	remove(binaryName.c_str());
+
+	bool match = textLoaded && binaryLoaded && tablesBuilt && textHash == binaryHash;
+
+	PRINT("Map:         %d x %d, %u objects, text %.1f MB, binary %.1f MB, cells %s\n", size, size, spawnNum,
+		textMB, binaryMB, match ? "match" : "DIFFER");
+	PRINT("Convert:     %.3f s\n", convertSeconds.count());
+	PRINT("Text:        %.3f s import\n", textSeconds.count());
+	PRINT("Binary:      %.3f s import\n", binarySeconds.count());
+	PRINT("Tables:      %.3f s of each import is the distance field and the rectangles\n", tableSeconds.count());
+	PRINT("Mapping:     %.3f s to map and check the binary file and read every cell (sum %llu)\n", mapSeconds.count(),
+		(unsigned long long)cellSum);
+
+	return match ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	The text level parser before it was rewritten: operator>> into a
+	temporary [row][column] array, then a copy into [column][row] arrays
+*/
+/******************************************************************************/
+static int** LegacyImport(const char *FileName, int *pWidth, int *pHeight)
+{
+	std::fstream stream{ FileName };
+	if (!stream.good())
+		return 0;
+
+	std::string tmpArg;
+	stream >> tmpArg >> *pWidth;
+	stream >> tmpArg >> *pHeight;
+
+	int **temp = new int* [*pHeight];
+
+	for (int x = 0; x < *pHeight; x++)
+	{
+		temp[x] = new int[*pWidth];
+		for (int y = 0; y < *pWidth; y++)
+			stream >> temp[x][y];
+	}
+
+	int **ppMap = new int* [*pWidth];
+
+	for (int i = 0; i < *pWidth; i++)
+		ppMap[i] = new int[*pHeight];
+
+	for (int x = 0; x < *pHeight; x++)
+		for (int y = 0; y < *pWidth; y++)
+			ppMap[y][x] = temp[x][y];
+
+	for (int i = 0; i < *pHeight; i++)
+		delete[] temp[i];
+
+	delete[] temp;
+
+	return ppMap;
+}
+
+/******************************************************************************/
+/*!
+	Writes a generated text level and parses it with the old and the new
+	parser. The new import also fills the collision map and builds the
+	distance field and the rectangles, which are timed on their own and
+	taken out, so the new parser is charged for filling the collision
+	map and the spawn list while the old one is not.
+*/
+/******************************************************************************/
+static int TextParseBenchmark(int size, const char *BaseName)
+{
+	std::string textName = std::string(BaseName) + ".txt";
+
+	if (!WriteTextLevel(textName.c_str(), size))
+	{
+		PRINT("Could not write %s\n", textName.c_str());
+		return 1;
+	}
+
+	std::ifstream	textStream{ textName, std::ios::binary | std::ios::ate };
+	double			textMB = (double)textStream.tellg() / (1024.0 * 1024.0);
+
+	textStream.close();
+
+	/*OLD PARSER*/
+	int width = 0, height = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	int **ppLegacy = LegacyImport(textName.c_str(), &width, &height);
+
+	std::chrono::duration<double> legacySeconds = std::chrono::steady_clock::now() - start;
+
+	/*NEW PARSER*/
+	start = std::chrono::steady_clock::now();
+
+	int loaded = ImportMapDataFromFile(textName.c_str());
+
+	std::chrono::duration<double> importSeconds = std::chrono::steady_clock::now() - start;
+
+	DistanceField	field;
+	ColliderList	list;
+
+	memset(&list, 0, sizeof(ColliderList));
+	start = std::chrono::steady_clock::now();
+
+	bool tablesBuilt = loaded && DistanceFieldInit(&field, BinaryCollisionMap) && ColliderListBuild(&list, BinaryCollisionMap);
+
+	std::chrono::duration<double> tableSeconds = std::chrono::steady_clock::now() - start;
+
+	if (tablesBuilt)
+		DistanceFieldFree(&field);
+
+	ColliderListFree(&list);
+
+	bool match = ppLegacy && loaded && tablesBuilt && width == BINARY_MAP_WIDTH && height == BINARY_MAP_HEIGHT;
+
+	for (int x = 0; match && x < width; ++x)
+		for (int y = 0; match && y < height; ++y)
+			match = ppLegacy[x][y] == TileGridGet(MapData, x, y);
+
+	FreeMapData();
+
+	for (int x = 0; ppLegacy && x < width; ++x)
+		delete[] ppLegacy[x];
+
+	delete[] ppLegacy;
+	remove(textName.c_str());
+
+	double parseSeconds = importSeconds.count() - tableSeconds.count();
+
+	PRINT("Map:         %d x %d, text %.1f MB, cells %s\n", size, size, textMB, match ? "match" : "DIFFER");
+	PRINT("Old parser:  %.3f s, %.1f MB/s\n", legacySeconds.count(), textMB / legacySeconds.count());
+	PRINT("New parser:  %.3f s, %.1f MB/s (%.3f s import less %.3f s of tables)\n", parseSeconds,
+		textMB / (parseSeconds > 0.0 ? parseSeconds : 1e-9), importSeconds.count(), tableSeconds.count());
+
+	return match ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Switches between level 1 and level 2 the way the game loop does, Free
+	and Unload of one level then Load and Init of the other, and times
+	each switch. Each level is played for 60 frames in between. Meshes
+	are not part of the headless build, so only the simulation side of a
+	switch is timed.
+*/
+/******************************************************************************/
+static int TransitionBenchmark(unsigned int switchNum)
+{
+	const char	*LevelName[2]	= { "../Resources/Levels/Exported.txt", "../Resources/Levels/Exported2.txt" };
+	double		totalSeconds	= 0.0, minSeconds = 0.0, maxSeconds = 0.0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i <= switchNum; ++i)
+	{
+		if (i > 0)
+		{
+			PlatformSimFree();
+			PlatformSimUnload();
+		}
+
+		if (!PlatformSimLoad(LevelName[i % 2]))
+		{
+			PRINT("Could not load level %s\n", LevelName[i % 2]);
+			PlatformSimUnload();
+			return 1;
+		}
+
+		PlatformSimInit();
+
+		std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+		// the first load has no level before it
+		if (i > 0)
+		{
+			totalSeconds	+= seconds.count();
+			minSeconds		= 1 == i || seconds.count() < minSeconds ? seconds.count() : minSeconds;
+			maxSeconds		= seconds.count() > maxSeconds ? seconds.count() : maxSeconds;
+		}
+
+		for (unsigned int frame = 0; frame < 60; ++frame)
+		{
+			PlatformSimInput input;
+			ScriptedInput(frame, &input);
+			PlatformSimUpdate(input);
+		}
+
+		start = std::chrono::steady_clock::now();
+	}
+
+	PlatformSimFree();
+	PlatformSimUnload();
+
+	PRINT("Switches:    %u between level 1 and level 2\n", switchNum);
+	PRINT("Transition:  %.3f ms average, %.3f ms min, %.3f ms max\n", totalSeconds * 1000.0 / (switchNum ? switchNum : 1),
+		minSeconds * 1000.0, maxSeconds * 1000.0);
+
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	Loads a level, runs it for 10 frames and returns the state checksum
+*/
+/******************************************************************************/
+static u64 LoadAndRun(const char *FileName, double *pLoadSeconds)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	int loaded = PlatformSimLoad(FileName);
+
+	std::chrono::duration<double> loadSeconds = std::chrono::steady_clock::now() - start;
+
+	*pLoadSeconds	= loadSeconds.count();
+	u64 hash		= 0;
+
+	if (loaded)
+	{
+		PlatformSimInit();
+
+		// particles are random, every run starts from the same seed
+		srand(1);
+
+		for (unsigned int frame = 0; frame < 10; ++frame)
+		{
+			PlatformSimInput input;
+			ScriptedInput(frame, &input);
+			PlatformSimUpdate(input);
+		}
+
+		hash = StateChecksum();
+		PlatformSimFree();
+	}
+
+	PlatformSimUnload();
+
+	return hash;
+}
+
+/******************************************************************************/
+/*!
+	Times the switch from level 1 to a generated level the way the game
+	makes it: loading the level when level 1 is cleared, reading it in the
+	background while level 1 is played for a number of frames at 60 per
+	second, and reading it in the background but switching straight away.
+	The three loads have to give the same level.
+*/
+/******************************************************************************/
+static int PreloadBenchmark(int size, const char *BaseName, unsigned int frameNum)
+{
+	std::string	levelName	= std::string(BaseName) + ".txt";
+	const char	*FirstName	= "../Resources/Levels/Exported.txt";
+
+	if (!WriteTextLevel(levelName.c_str(), size))
+	{
+		PRINT("Could not write %s\n", levelName.c_str());
+		return 1;
+	}
+
+	/*LOAD ON THE SWITCH*/
+	double	syncSeconds	= 0.0;
+	u64		syncHash	= LoadAndRun(levelName.c_str(), &syncSeconds);
+
+	/*READ WHILE LEVEL 1 IS PLAYED*/
+	double	playSeconds	= 0.0;
+
+	// the paths are relative to the project directory, like the game's
+	if (!PlatformSimLoad(FirstName))
+	{
+		PRINT("Could not load level 1 from %s\n", FirstName);
+		PlatformSimUnload();
+		remove(levelName.c_str());
+		return 1;
+	}
+
+	PlatformSimPreload(levelName.c_str());
+	PlatformSimInit();
+
+	std::chrono::steady_clock::time_point	start	= std::chrono::steady_clock::now();
+	std::chrono::microseconds				frameTime(16667);
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		PlatformSimInput input;
+		ScriptedInput(frame, &input);
+		PlatformSimUpdate(input);
+
+		std::this_thread::sleep_until(start + frameTime * (frame + 1));
+	}
+
+	PlatformSimFree();
+	PlatformSimUnload();
+
+	u64 playHash = LoadAndRun(levelName.c_str(), &playSeconds);
+
+	/*READ, THEN SWITCH STRAIGHT AWAY*/
+	double	earlySeconds	= 0.0;
+
+	PlatformSimPreload(levelName.c_str());
+
+	u64		earlyHash		= LoadAndRun(levelName.c_str(), &earlySeconds);
+
+	PlatformSimPreloadFree();
+
+	std::ifstream	levelStream{ levelName, std::ios::binary | std::ios::ate };
+	double			levelMB = (double)levelStream.tellg() / (1024.0 * 1024.0);
+
+	levelStream.close();
+	remove(levelName.c_str());
+
+	bool match = syncHash && syncHash == playHash && syncHash == earlyHash;
+
+	PRINT("Map:         %d x %d, text %.1f MB, levels %s\n", size, size, levelMB, match ? "match" : "DIFFER");
+	PRINT("On switch:   %.3f ms stall, the whole load\n", syncSeconds * 1000.0);
+	PRINT("Preloaded:   %.3f ms stall after %u frames of level 1\n", playSeconds * 1000.0, frameNum);
+	PRINT("Straight:    %.3f ms stall when the switch comes right after the preload starts\n", earlySeconds * 1000.0);
+
+	return match ? 0 : 1;
+}
+
+/******************************************************************************/
+/*!
+	Number of heroes and enemies whose centre is inside a collision cell
+	or outside of the map, which happens when they pass through a wall
+*/
+/******************************************************************************/
+static unsigned int CountTunneled(void)
+{
+	unsigned int num = 0;
+
+	for (unsigned int k = 0; k < gGameObjInstNum; ++k)
+	{
+		unsigned int	inst	= gGameObjInstLiveList[k];
+		unsigned int	type	= gameObjInst(inst)->pObject->type;
+		AEVec2			*pPos	= gameObjInstPos(inst);
+
+		if (type != TYPE_OBJECT_HERO && type != TYPE_OBJECT_ENEMY1)
+			continue;
+
+		if (pPos->x < 0.f || pPos->x >= BINARY_MAP_WIDTH ||
+			pPos->y < 0.f || pPos->y >= BINARY_MAP_HEIGHT ||
+			GetCellValue((int)pPos->x, (int)pPos->y))
+			++num;
+	}
+
+	return num;
+}
+
+/******************************************************************************/
+/*!
+	Loads a level and runs it for a number of fixed frames. A lost or cleared
+	level is started again, the same way the game restarts it.
+	A speed above 1 makes every frame that many times longer.
+*/
+/******************************************************************************/
+int main(int argc, char **argv)
+{
+	const char		*FileName	= argc > 1 ? argv[1] : "../Resources/Levels/Exported.txt";
+	unsigned int	frameNum	= argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 10000;
+	f32				speed		= argc > 3 ? (f32)atof(argv[3]) : 1.f;
+	unsigned int	lostNum		= 0;
+	unsigned int	clearedNum	= 0;
+	unsigned int	tunneledNum	= 0;
+
+	// same frame time as the capped game loop
+	g_dt = 0.01667f;
+
+	if (0 == strcmp(FileName, "-churn"))
+		return ChurnBenchmark(	argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 2,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 1000000);
+
+	if (0 == strcmp(FileName, "-layout"))
+		return LayoutBenchmark(	argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 65536,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 100000000);
+
+	if (0 == strcmp(FileName, "-pool"))
+		return PoolBenchmark(	argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 1000000,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 100,
+								argc > 4 ? (unsigned int)strtoul(argv[4], 0, 10) : 1);
+
+	if (0 == strcmp(FileName, "-coins"))
+		return CoinBenchmark(	argc > 2 ? atoi(argv[2]) : 10,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 2000);
+
+	if (0 == strcmp(FileName, "-fused"))
+		return FusedBenchmark(	argc > 2 ? atoi(argv[2]) : 10,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 2000);
+
+	if (0 == strcmp(FileName, "-broadphase"))
+		return BroadphaseBenchmark(	argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 50000,
+									argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 100);
+
+	if (0 == strcmp(FileName, "-rectbatch"))
+		return RectBatchBenchmark(	argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 10003,
+									argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 1000);
+
+	if (0 == strcmp(FileName, "-contacts"))
+		return ContactBenchmark(argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 13500,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 1000);
+
+	if (0 == strcmp(FileName, "-colliders"))
+		return ColliderBenchmark(	argc > 2 ? argv[2] : "../Resources/Levels/Exported2.txt",
+									argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 1000000);
+
+	if (0 == strcmp(FileName, "-rays"))
+		return RayBenchmark(argc > 2 ? argv[2] : "../Resources/Levels/Exported2.txt",
+							argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 1000000);
+
+	if (0 == strcmp(FileName, "-probes"))
+		return ProbeBenchmark(	argc > 2 ? atoi(argv[2]) : 4096,
+								argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 10000000);
+
+	if (0 == strcmp(FileName, "-distance"))
+		return DistanceBenchmark(	argc > 2 ? atoi(argv[2]) : 1024,
+									argc > 3 ? (unsigned int)strtoul(argv[3], 0, 10) : 10000);
+
+	if (0 == strcmp(FileName, "-convert"))
+		return ConvertLevel(argc > 2 ? argv[2] : "../Resources/Levels/Exported.txt",
+							argc > 3 ? argv[3] : "Exported.lvl");
+
+	if (0 == strcmp(FileName, "-levelload"))
+		return LevelLoadBenchmark(	argc > 2 ? atoi(argv[2]) : 8192,
+									argc > 3 ? argv[3] : "LevelLoad");
+
+	if (0 == strcmp(FileName, "-transition"))
+		return TransitionBenchmark(argc > 2 ? (unsigned int)strtoul(argv[2], 0, 10) : 1000);
+
+	if (0 == strcmp(FileName, "-preload"))
+		return PreloadBenchmark(argc > 2 ? atoi(argv[2]) : 2048,
+								argc > 3 ? argv[3] : "Preload",
+								argc > 4 ? (unsigned int)strtoul(argv[4], 0, 10) : 120);
+
+	if (0 == strcmp(FileName, "-textparse"))
+		return TextParseBenchmark(	argc > 2 ? atoi(argv[2]) : 4096,
+									argc > 3 ? argv[3] : "TextParse");
+
+	if (!PlatformSimLoad(FileName))
+	{
+		PRINT("Could not load level %s\n", FileName);
+		PlatformSimUnload();
+		return 1;
+	}
+
+	PlatformSimInit();
+	g_dt *= speed;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int frame = 0; frame < frameNum; ++frame)
+	{
+		PlatformSimInput input;
+		ScriptedInput(frame, &input);
+
+		PLATFORM_SIM_RESULT result = PlatformSimUpdate(input);
+
+		if (result != PLATFORM_SIM_RESULT_NONE)
+		{
+			result == PLATFORM_SIM_RESULT_LOST ? ++lostNum : ++clearedNum;
+
+			PlatformSimFree();
+			PlatformSimInit();
+		}
+
+		tunneledNum += CountTunneled();
+	}
+
+	std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+	PRINT("Level:       %s (%d x %d)\n", FileName, BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT);
+	PRINT("Frames:      %u at %gx speed (lost %u, cleared %u)\n", frameNum, speed, lostNum, clearedNum);
+	PRINT("Tunneled:    %u instance frames inside a wall or outside of the map\n", tunneledNum);
+	PRINT("Time:        %.3f s\n", seconds.count());
+	PRINT("Frames/sec:  %.1f\n", frameNum / seconds.count());
+	PRINT("Checksum:    %016llx\n", (unsigned long long)StateChecksum());
+
+	PlatformSimFree();
+	PlatformSimUnload();
+
+	return 0;
+}
@@ -0,0 +1,312 @@
+/******************************************************************************/
+/*!
+\file		LevelFile.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Binary level file that is mapped into memory and read in place.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/******************************************************************************/
+/*!
+	Maps a whole file copy-on-write, returns the view or 0. Writes to the
+	view stay in memory and never reach the file.
+*/
+/******************************************************************************/
+static void* MapFile(const char *FileName, size_t *pSize)
+{
+	void *pView = 0;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(FileName, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+
+	if (INVALID_HANDLE_VALUE == file)
+		return 0;
+
+	LARGE_INTEGER	size;
+	HANDLE			mapping = 0;
+
+	// an empty file cannot be mapped
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+		mapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+
+	// the view keeps the file and the mapping open
+	CloseHandle(file);
+
+	if (0 == mapping)
+		return 0;
+
+	pView = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	*pSize = (size_t)size.QuadPart;
+
+	CloseHandle(mapping);
+#else
+	int			file = open(FileName, O_RDONLY);
+	struct stat	info;
+
+	if (file < 0)
+		return 0;
+
+	// an empty file cannot be mapped
+	if (0 == fstat(file, &info) && info.st_size > 0)
+	{
+		pView = mmap(0, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+		pView = MAP_FAILED == pView ? 0 : pView;
+		*pSize = (size_t)info.st_size;
+	}
+
+	// the view keeps the file open
+	close(file);
+#endif
+
+	return pView;
+}
+
+/******************************************************************************/
+/*!
+	Unmaps a view from MapFile
+*/
+/******************************************************************************/
+static void UnmapFile(const void *pView, size_t size)
+{
+#ifdef _WIN32
+	UNREFERENCED_PARAMETER(size);
+	UnmapViewOfFile(pView);
+#else
+	munmap((void*)pView, size);
+#endif
+}
+
+/******************************************************************************/
+/*!
+	Checks that every cell holds an object type and that the spawn table
+	is the one LevelFileWrite writes for the cells, the same objects in
+	the same order
+*/
+/******************************************************************************/
+static bool levelFileCheckCells(const LevelFileHeader *pHeader, const unsigned char *pCells, const LevelSpawn *pSpawn)
+{
+	size_t cellNum = (size_t)pHeader->width * pHeader->height;
+
+	// a cell holds an object type, anything else would be stored as some other type
+	for (size_t i = 0; i < cellNum; ++i)
+		if (pCells[i] >= TYPE_OBJECT_NUM)
+			return false;
+
+	int				width		= (int)pHeader->width;
+	int				height		= (int)pHeader->height;
+	unsigned int	spawnNum	= LevelFileSpawns(pCells, width, height, 0);
+
+	if (spawnNum != pHeader->spawnNum)
+		return false;
+
+	if (0 == spawnNum)
+		return true;
+
+	LevelSpawn *pExpected = (LevelSpawn*)malloc(spawnNum * sizeof(LevelSpawn));
+
+	if (0 == pExpected)
+		return false;
+
+	LevelFileSpawns(pCells, width, height, pExpected);
+
+	bool valid = 0 == memcmp(pExpected, pSpawn, spawnNum * sizeof(LevelSpawn));
+
+	free(pExpected);
+
+	return valid;
+}
+
+/******************************************************************************/
+/*!
+	Maps a level file and checks that the header and the tables fit in it,
+	that the cells hold object types and that the spawns agree with the
+	cells. Returns false for a missing file or a file that is not a valid
+	level file, such as a text level.
+*/
+/******************************************************************************/
+bool LevelFileOpen(LevelFile *pFile, const char *FileName)
+{
+	memset(pFile, 0, sizeof(LevelFile));
+
+	size_t	size	= 0;
+	void	*pView	= MapFile(FileName, &size);
+
+	if (0 == pView)
+		return false;
+
+	const LevelFileHeader	*pHeader	= (const LevelFileHeader*)pView;
+	unsigned long long		cellEnd		= 0, spawnEnd = 0;
+	bool					valid		= size >= sizeof(LevelFileHeader);
+
+	valid = valid && LEVEL_FILE_MAGIC == pHeader->magic && LEVEL_FILE_VERSION == pHeader->version;
+
+	if (valid)
+	{
+		cellEnd		= pHeader->cellOffset	+ (unsigned long long)pHeader->width * pHeader->height;
+		spawnEnd	= pHeader->spawnOffset	+ (unsigned long long)pHeader->spawnNum * sizeof(LevelSpawn);
+
+		valid = pHeader->cellOffset >= sizeof(LevelFileHeader) && cellEnd <= size &&
+				pHeader->spawnOffset >= cellEnd && 0 == pHeader->spawnOffset % 4 && spawnEnd <= size &&
+				pHeader->width <= 0x7FFFFFFFu && pHeader->height <= 0x7FFFFFFFu;
+	}
+
+	unsigned char		*pBase	= (unsigned char*)pView;
+	const LevelSpawn	*pSpawn	= valid ? (const LevelSpawn*)(pBase + pHeader->spawnOffset) : 0;
+
+	// the level indexes its cells with the spawn positions and creates the spawns by type
+	valid = valid && levelFileCheckCells(pHeader, pBase + pHeader->cellOffset, pSpawn);
+
+	if (!valid)
+	{
+		UnmapFile(pView, size);
+		return false;
+	}
+
+	pFile->pHeader	= pHeader;
+	pFile->pCells	= pBase + pHeader->cellOffset;
+	pFile->pSpawn	= pSpawn;
+	pFile->size		= size;
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Unmaps the file, the pointers into it are no longer valid
+*/
+/******************************************************************************/
+void LevelFileClose(LevelFile *pFile)
+{
+	if (pFile->pHeader)
+		UnmapFile(pFile->pHeader, pFile->size);
+
+	memset(pFile, 0, sizeof(LevelFile));
+}
+
+/******************************************************************************/
+/*!
+	Lists the hero, enemy and coin cells of a level in the order the level
+	creates them, by column and then by row. pSpawn may be 0 to only count
+	them.
+
+	The cells are read in the order they are stored. The first pass counts
+	the objects of each column, which gives each column its place in the
+	list, and the second pass fills the columns, each one from its first
+	row up.
+*/
+/******************************************************************************/
+unsigned int LevelFileSpawns(const unsigned char *pCells, int width, int height, LevelSpawn *pSpawn)
+{
+	unsigned int		*pColumn	= (unsigned int*)calloc((size_t)width + 1, sizeof(unsigned int));
+	unsigned int		num			= 0;
+	const unsigned char	*pCell		= pCells;
+
+	if (0 == pColumn)
+		return 0;
+
+	/*COUNT*/
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x, ++pCell)
+		{
+			unsigned int type = *pCell;
+
+			pColumn[x + 1] += type == TYPE_OBJECT_HERO || type == TYPE_OBJECT_ENEMY1 || type == TYPE_OBJECT_COIN;
+		}
+
+	for (int x = 0; x < width; ++x)
+		num += pColumn[x + 1];
+
+	if (0 == pSpawn)
+	{
+		free(pColumn);
+		return num;
+	}
+
+	/*FIRST ENTRY OF EACH COLUMN*/
+	for (int x = 0; x < width; ++x)
+		pColumn[x + 1] += pColumn[x];
+
+	/*FILL*/
+	pCell = pCells;
+
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x, ++pCell)
+		{
+			unsigned int type = *pCell;
+
+			if (type != TYPE_OBJECT_HERO && type != TYPE_OBJECT_ENEMY1 && type != TYPE_OBJECT_COIN)
+				continue;
+
+			LevelSpawn *pEntry = pSpawn + pColumn[x]++;
+
+			pEntry->x		= (unsigned int)x;
+			pEntry->y		= (unsigned int)y;
+			pEntry->type	= type;
+		}
+
+	free(pColumn);
+
+	return num;
+}
+
+/******************************************************************************/
+/*!
+	Writes the cells of a level, in rows from y = 0, as a level file
+	together with its spawn table
+*/
+/******************************************************************************/
+bool LevelFileWrite(const char *FileName, const unsigned char *pCells, int width, int height)
+{
+	size_t			cellNum		= (size_t)width * height;
+	unsigned int	spawnNum	= LevelFileSpawns(pCells, width, height, 0);
+	LevelSpawn		*pSpawn		= (LevelSpawn*)malloc((spawnNum ? spawnNum : 1) * sizeof(LevelSpawn));
+	LevelFileHeader	header;
+	const char		padding[4]	= { 0, 0, 0, 0 };
+
+	// the offsets in the header are 32 bits
+	if (0 == pSpawn || sizeof(LevelFileHeader) + cellNum + 3 > 0xFFFFFFFFu - (size_t)spawnNum * sizeof(LevelSpawn))
+	{
+		free(pSpawn);
+		return false;
+	}
+
+	LevelFileSpawns(pCells, width, height, pSpawn);
+
+	header.magic		= LEVEL_FILE_MAGIC;
+	header.version		= LEVEL_FILE_VERSION;
+	header.width		= (unsigned int)width;
+	header.height		= (unsigned int)height;
+	header.cellOffset	= sizeof(LevelFileHeader);
+	header.spawnOffset	= (unsigned int)((header.cellOffset + cellNum + 3) & ~(size_t)3);
+	header.spawnNum		= spawnNum;
+	header.reserved		= 0;
+
+	std::ofstream stream{ FileName, std::ios::binary | std::ios::trunc };
+
+	stream.write((const char*)&header,	sizeof(LevelFileHeader));
+	stream.write((const char*)pCells,	(std::streamsize)cellNum);
+	stream.write(padding,				(std::streamsize)(header.spawnOffset - header.cellOffset - cellNum));
+	stream.write((const char*)pSpawn,	(std::streamsize)spawnNum * sizeof(LevelSpawn));
+
+	free(pSpawn);
+
+	return stream.good();
+}
@@ -0,0 +1,197 @@
+/******************************************************************************/
+/*!
+\file		MapQuery.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Ray, box and ground queries against the collision map.
+
+			Rays walk the grid one cell at a time in the order the ray
+			enters them (Amanatides and Woo), each step is one compare and
+			one add. Boxes read the bits of a row a word at a time.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+
+/******************************************************************************/
+/*!
+	Defines
+*/
+/******************************************************************************/
+const float		MAP_QUERY_NEVER		= 1e30f;	// time to the next grid line along an axis the ray does not move on
+
+/******************************************************************************/
+/*!
+	Casts a ray through the collision map. Returns true and fills pHit with
+	the first collision cell the ray enters, or returns false with pHit->t
+	set to maxT. A ray that starts in a collision cell hits it at t = 0.
+	Cells outside of the map are empty.
+*/
+/******************************************************************************/
+bool MapQueryRaycast(const CollisionMap &map, const MapRay &ray, MapRayHit *pHit)
+{
+	int		x		= (int)floorf(ray.origin.x);
+	int		y		= (int)floorf(ray.origin.y);
+	int		stepX	= ray.dir.x > 0.f ? 1 : (ray.dir.x < 0.f ? -1 : 0);
+	int		stepY	= ray.dir.y > 0.f ? 1 : (ray.dir.y < 0.f ? -1 : 0);
+
+	// time to cross one cell, and to reach the first grid line
+	float	deltaX	= stepX ? fabsf(1.f / ray.dir.x) : MAP_QUERY_NEVER;
+	float	deltaY	= stepY ? fabsf(1.f / ray.dir.y) : MAP_QUERY_NEVER;
+	float	tX		= stepX > 0 ? (x + 1 - ray.origin.x) * deltaX : (stepX ? (ray.origin.x - x) * deltaX : MAP_QUERY_NEVER);
+	float	tY		= stepY > 0 ? (y + 1 - ray.origin.y) * deltaY : (stepY ? (ray.origin.y - y) * deltaY : MAP_QUERY_NEVER);
+	float	t		= 0.f;
+
+	AEVec2Zero(&pHit->normal);
+
+	for (;;)
+	{
+		if (CollisionMapGet(map, x, y))
+		{
+			pHit->t		= t;
+			pHit->cellX	= x;
+			pHit->cellY	= y;
+			pHit->hit	= true;
+			return true;
+		}
+
+		// past the map edge and moving away from it, nothing more to hit
+		if ((x < 0 && stepX <= 0) || (x >= map.width && stepX >= 0) ||
+			(y < 0 && stepY <= 0) || (y >= map.height && stepY >= 0))
+			break;
+
+		// a ray without a direction only tests the cell it starts in, t would never reach maxT
+		if (0 == stepX && 0 == stepY)
+			break;
+
+		if (tX < tY)
+		{
+			t	= tX;
+			x	+= stepX;
+			tX	+= deltaX;
+			AEVec2Set(&pHit->normal, (float)-stepX, 0.f);
+		}
+		else
+		{
+			t	= tY;
+			y	+= stepY;
+			tY	+= deltaY;
+			AEVec2Set(&pHit->normal, 0.f, (float)-stepY);
+		}
+
+		if (t > ray.maxT)
+			break;
+	}
+
+	AEVec2Zero(&pHit->normal);
+	pHit->t		= ray.maxT;
+	pHit->cellX	= x;
+	pHit->cellY	= y;
+	pHit->hit	= false;
+	return false;
+}
+
+/******************************************************************************/
+/*!
+	Casts num rays, hit i is the result of ray i
+*/
+/******************************************************************************/
+void MapQueryRaycastBatch(const CollisionMap &map, const MapRay *pRay, unsigned int num, MapRayHit *pHit)
+{
+	for (unsigned int i = 0; i < num; ++i)
+		MapQueryRaycast(map, pRay[i], pHit + i);
+}
+
+/******************************************************************************/
+/*!
+	Returns true if the box overlaps a collision cell, touching one does not
+	count. Each row is read a word at a time.
+*/
+/******************************************************************************/
+bool MapQueryBoxOverlap(const CollisionMap &map, const AABB &box)
+{
+	// cells the box covers, clamped to the map
+	int x0 = (int)floorf(box.min.x);
+	int y0 = (int)floorf(box.min.y);
+	int x1 = (int)ceilf(box.max.x) - 1;
+	int y1 = (int)ceilf(box.max.y) - 1;
+
+	x0 = x0 < 0 ? 0 : x0;
+	y0 = y0 < 0 ? 0 : y0;
+	x1 = x1 < map.width ? x1 : map.width - 1;
+	y1 = y1 < map.height ? y1 : map.height - 1;
+
+	if (x0 > x1 || y0 > y1)
+		return false;
+
+	unsigned int w0		= x0 >> 5, w1 = x1 >> 5;
+	unsigned int mask0	= ~0u << (x0 & 31);
+	unsigned int mask1	= ~0u >> (31 - (x1 & 31));
+
+	for (int y = y0; y <= y1; ++y)
+	{
+		const unsigned int *pRow = map.pWords + y * map.rowWords;
+
+		if (w0 == w1)
+		{
+			if (pRow[w0] & mask0 & mask1)
+				return true;
+			continue;
+		}
+
+		if ((pRow[w0] & mask0) | (pRow[w1] & mask1))
+			return true;
+
+		for (unsigned int w = w0 + 1; w < w1; ++w)
+			if (pRow[w])
+				return true;
+	}
+
+	return false;
+}
+
+/******************************************************************************/
+/*!
+	Tests num boxes, bit i of pHitMask is set if box i overlaps a collision
+	cell. pHitMask must hold (num + 31) / 32 words. Returns the number of
+	boxes that overlap.
+*/
+/******************************************************************************/
+unsigned int MapQueryBoxOverlapBatch(const CollisionMap &map, const AABB *pBox, unsigned int num, unsigned int *pHitMask)
+{
+	unsigned int hitNum = 0;
+
+	memset(pHitMask, 0, (num + 31) / 32 * sizeof(unsigned int));
+
+	for (unsigned int i = 0; i < num; ++i)
+		if (MapQueryBoxOverlap(map, pBox[i]))
+		{
+			pHitMask[i / 32] |= 1u << (i % 32);
+			++hitNum;
+		}
+
+	return hitNum;
+}
+
+/******************************************************************************/
+/*!
+	Row of the first collision cell under cell (X, Y), -1 if the column is
+	empty all the way down or X is outside of the map
+*/
+/******************************************************************************/
+int MapQuerySolidBelow(const CollisionMap &map, int X, int Y)
+{
+	if ((unsigned int)X >= (unsigned int)map.width)
+		return -1;
+
+	for (int y = (Y < map.height ? Y : map.height) - 1; y >= 0; --y)
+		if (CollisionMapGet(map, X, y))
+			return y;
+
+	return -1;
+}
@@ -0,0 +1,104 @@
+/******************************************************************************/
+/*!
+\file		MeshCache.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "main.h"
+
+/******************************************************************************
+	Defines
+******************************************************************************/
+const unsigned int	MESH_CACHE_NUM_MAX		= 32;			//The total number of different meshes that can be cached
+
+/******************************************************************************
+	Struct
+******************************************************************************/
+struct MeshCacheEntry
+{
+	// description of the mesh
+	MESH_SHAPE			shape;
+	u32					color;
+	u32					parts;
+
+	AEGfxVertexList		*pMesh;
+};
+
+// list of the meshes built so far
+static MeshCacheEntry	sMeshCacheList[MESH_CACHE_NUM_MAX];
+static unsigned int		sMeshCacheNum;
+
+/**************************************************************************/
+/*!
+	Returns the mesh matching the description, building it the first time
+	*/
+/**************************************************************************/
+AEGfxVertexList* MeshCacheGet(MESH_SHAPE shape, u32 color, u32 parts)
+{
+	for (unsigned int i = 0; i < sMeshCacheNum; ++i)
+	{
+		MeshCacheEntry *pEntry = sMeshCacheList + i;
+
+		if (pEntry->shape == shape && pEntry->color == color && pEntry->parts == parts)
+			return pEntry->pMesh;
+	}
+
+	AE_ASSERT_MESG(sMeshCacheNum < MESH_CACHE_NUM_MAX, "mesh cache is full");
+
+	AEGfxMeshStart();
+
+	switch (shape)
+	{
+	case MESH_SHAPE_QUAD:
+		AEGfxTriAdd(
+			-0.5f,	-0.5f,	color, 0.0f, 0.0f,
+			0.5f,	-0.5f,	color, 0.0f, 0.0f,
+			-0.5f,	0.5f,	color, 0.0f, 0.0f);
+
+		AEGfxTriAdd(
+			-0.5f,	0.5f,	color, 0.0f, 0.0f,
+			0.5f,	-0.5f,	color, 0.0f, 0.0f,
+			0.5f,	0.5f,	color, 0.0f, 0.0f);
+		break;
+
+	case MESH_SHAPE_CIRCLE:
+		for (float i = 0; i < parts; ++i)
+		{
+			AEGfxTriAdd(
+				0.0f,									0.0f,									color, 0.0f, 0.0f,
+				cosf(i * 2 * PI / parts) * 0.5f,		sinf(i * 2 * PI / parts) * 0.5f,		color, 0.0f, 0.0f,
+				cosf((i + 1) * 2 * PI / parts) * 0.5f,	sinf((i + 1) * 2 * PI / parts) * 0.5f,	color, 0.0f, 0.0f);
+		}
+		break;
+	}
+
+	MeshCacheEntry *pEntry = sMeshCacheList + sMeshCacheNum++;
+
+	pEntry->shape	= shape;
+	pEntry->color	= color;
+	pEntry->parts	= parts;
+	pEntry->pMesh	= AEGfxMeshEnd();
+
+	return pEntry->pMesh;
+}
+
+/**************************************************************************/
+/*!
+	Frees every cached mesh
+	*/
+/**************************************************************************/
+void MeshCacheFree(void)
+{
+	for (unsigned int i = 0; i < sMeshCacheNum; ++i)
+		AEGfxMeshFree(sMeshCacheList[i].pMesh);
+
+	sMeshCacheNum = 0;
+}
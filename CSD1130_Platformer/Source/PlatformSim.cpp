@@ -0,0 +1,1854 @@
+/******************************************************************************/
+/*!
+\file		PlatformSim.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+/******************************************************************************/
+
+#include "PlatformSim.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+/******************************************************************************/
+/*!
+	Simulation globals
+*/
+/******************************************************************************/
+int						HeroLives;		// Number of hero lives
+int						TotalCoins;		// Total coins in level
+
+// list of original objects
+GameObj					*gGameObjList;
+unsigned int			gGameObjNum;
+
+// object instance pool
+GameObjInstChunk		**gGameObjInstChunks;
+unsigned int			gGameObjInstNum;
+unsigned int			*gGameObjInstLiveList;
+GameObjInstHandleSlot	*gGameObjInstHandleList;
+unsigned int			gGameObjInstHandleNum;
+
+// particle array
+Particle				*gParticlesList;
+
+//Binary map data
+TileGrid				MapData;
+CollisionMap			BinaryCollisionMap;
+ColliderList			BinaryColliderList;
+DistanceField			BinaryDistanceField;
+int						BINARY_MAP_WIDTH;
+int						BINARY_MAP_HEIGHT;
+GameObjInstHandle		BlackInstance;
+GameObjInstHandle		WhiteInstance;
+
+/*HANDLE OF HERO INSTANCE*/
+GameObjInstHandle		HeroInstance;
+
+/******************************************************************************/
+/*!
+	File globals
+*/
+/******************************************************************************/
+static int				Hero_Initial_X;	// Initial x position of hero
+static int				Hero_Initial_Y; // Initial y position of hero
+static float			ParticleDelay;	// Delay between each particle generation
+static float			ParticleTimer;	// Timer to check if the delay is up
+static bool				FusedUpdate = true;	// Update instances in one fused pass instead of one pass per step
+static bool				GridBroadphase = true;	// Find rect-rect candidates with the uniform grid instead of testing the hero against each bucket
+static bool				SweptGridCollision = true;	// Sweep moves that are too long for the grid probes through the collision map
+static bool				SleepingCoins = true;	// Put coins to sleep when they spawn, the instance passes only visit awake instances
+
+static unsigned int		sGameObjInstChunkNum;
+
+// stack of unused instance slots, the top is handed out by the next create
+static unsigned int		*sGameObjInstFreeList;
+static unsigned int		sGameObjInstFreeNum;
+
+// active instance slots grouped by TYPE_OBJECT
+static GameObjInstBucket	sGameObjInstBucket[TYPE_OBJECT_NUM];
+
+// active instances the update passes visit, sleeping ones keep their box and matrix
+static unsigned int			*sGameObjInstAwakeList;
+static unsigned int			sGameObjInstAwakeNum;
+
+// stack of unused handle slots
+static unsigned int				*sGameObjInstHandleFreeList;
+static unsigned int				sGameObjInstHandleFreeNum;
+
+// set once destroys leave a whole chunk that compacting would release, the pool is compacted before the next update
+static bool						sGameObjInstPoolDirty;
+
+// rect-rect candidates, one cell per tile
+static Broadphase		sBroadphase;
+
+// rect-rect contacts of the frame, the gameplay response reads them after the narrowphase
+static ContactQueue		sContactQueue;
+
+// a binary level stays mapped while it is loaded, its spawn table is read in place
+static LevelFile			sLevelFile;
+
+// objects of the level in the order they are created, points into sLevelFile or is allocated for a text level
+static const LevelSpawn	*sSpawnList;
+static unsigned int		sSpawnNum;
+
+/**************************************************************************/
+/*!
+	Everything that is read for a level, before it becomes the current map
+	*/
+/**************************************************************************/
+struct LevelMap
+{
+	TileGrid			grid;
+	CollisionMap		collision;
+	ColliderList		colliders;
+	DistanceField		distance;
+	LevelFile			file;			// pHeader is 0 for a text level
+	const LevelSpawn	*pSpawn;
+	unsigned int		spawnNum;
+};
+
+/**************************************************************************/
+/*!
+	A level read on a background thread. The thread only touches map and
+	result, which belong to the loading code again once it is joined.
+	*/
+/**************************************************************************/
+struct LevelPreload
+{
+	std::thread			thread;
+	std::string			fileName;		// empty when the slot is free
+	LevelMap			map;
+	int					result;			// what LevelMapImport returned
+};
+
+static LevelPreload		sLevelPreload[LEVEL_PRELOAD_MAX];
+
+/*GAME OBJECT INSTANCE FUNCTIONS*/
+static void				gameObjInstPoolReset(void);
+static bool				gameObjInstPoolGrow(void);
+static void				gameObjInstPoolCompact(void);
+static bool				gameObjInstBucketGrow(GameObjInstBucket* pBucket);
+static bool				gameObjInstHandleGrow(void);
+
+/*INSTANCE UPDATE STEPS*/
+static void				gameObjInstPhysics			(unsigned int inst);
+static void				gameObjInstUpdatePosition	(unsigned int inst);
+static bool				gameObjInstSweep			(unsigned int inst, AEVec2 delta, float skin);
+static void				gameObjInstGridCollision	(unsigned int inst);
+static void				gameObjInstTransformUpdate	(unsigned int inst);
+static void				gameObjInstHeroContact		(unsigned int inst, unsigned int slot);
+static void				gameObjInstContactResponse	(const ContactEvent &contact, PLATFORM_SIM_RESULT *pResult);
+static void				rectRectNarrowphase			(unsigned int hero, unsigned int begin, unsigned int end);
+
+/*LEVEL IMPORT FUNCTIONS*/
+static int				LevelPreloadTake(const char *FileName);
+
+/*STATE MACHINE FUNCTIONS*/
+void					EnemyStateMachine(unsigned int inst);
+
+/*PARTICLE FUNCTIONS*/
+f32						PRNG(f32 min, f32 max);
+void					CreateParticle(AEVec2 pos);
+
+/******************************************************************************/
+/*!
+	Allocates the simulation data and imports the level, returns 0 if the level could not be read
+*/
+/******************************************************************************/
+int PlatformSimLoad(const char *FileName)
+{
+	gGameObjList		= (GameObj*)	calloc(GAME_OBJ_NUM_MAX,		sizeof(GameObj)		);
+	gParticlesList		= (Particle*)	calloc(PARTICLES_MAX,			sizeof(Particle)	);
+	gGameObjNum			= 0;
+
+	// the instance pool starts empty and grows on demand
+	gGameObjInstChunks		= 0;
+	sGameObjInstChunkNum	= 0;
+	sGameObjInstFreeList	= 0;
+	gGameObjInstLiveList	= 0;
+	sGameObjInstAwakeList	= 0;
+
+	gGameObjInstHandleList		= 0;
+	gGameObjInstHandleNum		= 0;
+	sGameObjInstHandleFreeList	= 0;
+
+	for (unsigned int i = 0; i < TYPE_OBJECT_NUM; ++i)
+	{
+		sGameObjInstBucket[i].pList	= 0;
+		sGameObjInstBucket[i].max	= 0;
+	}
+
+	gameObjInstPoolReset();
+
+
+	GameObj* pObj;
+
+	// meshes are attached by the game state that draws the objects
+
+	//Creating the black object
+	pObj		= gGameObjList + gGameObjNum++;
+	pObj->type	= TYPE_OBJECT_EMPTY;
+
+	//Creating the white object
+	pObj		= gGameObjList + gGameObjNum++;
+	pObj->type	= TYPE_OBJECT_COLLISION;
+
+	//Creating the hero object
+	pObj		= gGameObjList + gGameObjNum++;
+	pObj->type	= TYPE_OBJECT_HERO;
+
+	//Creating the enemey1 object
+	pObj		= gGameObjList + gGameObjNum++;
+	pObj->type	= TYPE_OBJECT_ENEMY1;
+
+	//Creating the Coin object
+	pObj		= gGameObjList + gGameObjNum++;
+	pObj->type	= TYPE_OBJECT_COIN;
+
+	/*CREATE 4 PARTICLES WITH DIFFERENT COLORS*/
+	/*PARTICLE 1*/
+	pObj = gGameObjList + gGameObjNum++;
+	pObj->type = TYPE_OBJECT_PARTICLE;
+
+	/*PARTICLE 2*/
+	pObj = gGameObjList + gGameObjNum++;
+	pObj->type = TYPE_OBJECT_PARTICLE;
+
+	/*PARTICLE 3*/
+	pObj = gGameObjList + gGameObjNum++;
+	pObj->type = TYPE_OBJECT_PARTICLE;
+
+	/*PARTICLE 4*/
+	pObj = gGameObjList + gGameObjNum++;
+	pObj->type = TYPE_OBJECT_PARTICLE;
+	/*CREATE PARTICLES END*/
+
+	//Setting intital binary map values
+	memset(&MapData, 0, sizeof(TileGrid));
+	sSpawnList				= 0;
+	sSpawnNum				= 0;
+	memset(&sLevelFile, 0, sizeof(LevelFile));
+	memset(&BinaryCollisionMap, 0, sizeof(CollisionMap));
+	memset(&BinaryColliderList, 0, sizeof(ColliderList));
+	memset(&BinaryDistanceField, 0, sizeof(DistanceField));
+	BINARY_MAP_WIDTH		= 0;
+	BINARY_MAP_HEIGHT		= 0;
+
+	// a preloaded level is taken over as it is, the stall is waiting for it to finish
+	if (!LevelPreloadTake(FileName) && !ImportMapDataFromFile(FileName))
+		return 0;
+
+	// tiles are one unit wide, so a cell holds one tile
+	if (!BroadphaseInit(&sBroadphase, 1.f, BINARY_MAP_WIDTH, BINARY_MAP_HEIGHT))
+		return 0;
+
+	return ContactQueueInit(&sContactQueue) ? 1 : 0;
+}
+
+/******************************************************************************/
+/*!
+	Creates the object instances of the imported level
+*/
+/******************************************************************************/
+void PlatformSimInit(void)
+{
+	/*INITIALIZE VALUES*/
+	HeroInstance	= GAME_OBJ_INST_NONE;
+	BlackInstance	= GAME_OBJ_INST_NONE;
+	WhiteInstance	= GAME_OBJ_INST_NONE;
+	TotalCoins		= 0;
+	HeroLives		= HERO_LIVES;
+	ParticleDelay	= 1.f / EMISSION_RATE; // number of times per second
+	ParticleTimer	= 0;
+
+	// contacts of the last run refer to instances that are gone
+	ContactQueueClear(&sContactQueue);
+
+	/*BLACK TILE OBJECT INSTANCE*/
+	BlackInstance											= gameObjInstCreate(TYPE_OBJECT_EMPTY, 1.0f, 0, 0, 0.0f, STATE_NONE);
+	*gameObjInstFlag(gameObjInstResolve(BlackInstance))		^= FLAG_VISIBLE;
+	*gameObjInstFlag(gameObjInstResolve(BlackInstance))		|= FLAG_NON_COLLIDABLE;
+
+	/*WHITE TILE OBJECT INSTANCE*/
+	WhiteInstance											= gameObjInstCreate(TYPE_OBJECT_COLLISION, 1.0f, 0, 0, 0.0f, STATE_NONE);
+	*gameObjInstFlag(gameObjInstResolve(WhiteInstance))		^= FLAG_VISIBLE;
+	*gameObjInstFlag(gameObjInstResolve(WhiteInstance))		|= FLAG_NON_COLLIDABLE;
+
+	GameObjInstHandle inst;
+	AEVec2 Pos;
+
+	/*CREATING GAME OBJECT INSTANCES*/
+	// the spawn list holds the object cells of the map by column and row, the order the whole map was scanned in
+	for (unsigned int s = 0; s < sSpawnNum; ++s)
+	{
+		const LevelSpawn *pSpawn = sSpawnList + s;
+		AEVec2Set(&Pos, (f32)pSpawn->x + 0.5f, (f32)pSpawn->y + 0.5f);
+
+		switch (pSpawn->type) {
+
+		case(TYPE_OBJECT_HERO):
+			HeroInstance = gameObjInstCreate(TYPE_OBJECT_HERO, 1.0f, &Pos, 0, 0.f, STATE_NONE);
+			Hero_Initial_X = (int)pSpawn->x;
+			Hero_Initial_Y = (int)pSpawn->y;
+			break;
+
+		case(TYPE_OBJECT_ENEMY1):
+			inst = gameObjInstCreate(TYPE_OBJECT_ENEMY1, 1.0f, &Pos, 0, 0.f, STATE_GOING_RIGHT);
+			break;
+
+		case(TYPE_OBJECT_COIN):
+			inst = gameObjInstCreate(TYPE_OBJECT_COIN, 1.0f, &Pos, 0, 0.f, STATE_NONE);
+			TotalCoins++;
+
+			// coins never move
+			if (SleepingCoins && GAME_OBJ_INST_NONE != inst)
+				gameObjInstSleep(gameObjInstResolve(inst));
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+/******************************************************************************/
+/*!
+	Advances the level by one frame of g_dt
+*/
+/******************************************************************************/
+PLATFORM_SIM_RESULT PlatformSimUpdate(const PlatformSimInput &input)
+{
+	unsigned int i, k, inst;
+	PLATFORM_SIM_RESULT result = PLATFORM_SIM_RESULT_NONE;
+
+	// pack the live instances together before anything looks them up
+	if (sGameObjInstPoolDirty)
+		gameObjInstPoolCompact();
+
+	unsigned int hero		= gameObjInstResolve(HeroInstance);
+	GameObjInst	*pHero		= gameObjInst(hero);
+	AEVec2		*pHeroPos	= gameObjInstPos(hero);
+	AEVec2		*pHeroVel	= gameObjInstVel(hero);
+
+	/*HANDLE INPUT*/
+	/*MOVE LEFT AND RIGHT*/
+	if (input.right) {
+		pHeroVel->x			= MOVE_VELOCITY_HERO;
+		pHero->face			= FACE_RIGHT;
+	}
+	
+	else if (input.left) {
+		pHeroVel->x			= -MOVE_VELOCITY_HERO;
+		pHero->face			= FACE_LEFT;
+	}
+
+	else 
+		pHeroVel->x = 0.f;
+
+	/*JUMP MOVEMENT*/
+	if (input.jump) {
+		//Player can jump as long as they are colliding with the bottom
+		if (pHero->gridCollisionFlag & COLLISION_BOTTOM)
+			pHeroVel->y = JUMP_VELOCITY;
+		
+		/*
+		 * Player can jump if the previous collison was on the left or right 
+		 * and there is currently no collision on the left or right
+		 */
+		else if ((pHero->gridCollisionFlagPrev & COLLISION_LEFT || pHero->gridCollisionFlagPrev & COLLISION_RIGHT) &&
+				!(pHero->gridCollisionFlag & COLLISION_LEFT || pHero->gridCollisionFlag & COLLISION_RIGHT))
+		{
+			pHeroVel->y = JUMP_VELOCITY;
+		}
+
+		/*Reset prev collision flag to prevent double jumping mid air*/
+		pHero->gridCollisionFlagPrev = 0;
+	}
+
+	/*HANDLE INPUT END*/
+
+	/*PARTICLE GENERATION*/
+	/*CREATE PARTICLE BASED ON EMISSION RATE*/
+	ParticleTimer -= g_dt; // Decrement timer
+	if (ParticleTimer < 0) {
+		CreateParticle(*pHeroPos); // Create new particle
+		ParticleTimer = ParticleDelay; // Reset timer
+	}
+	/*PARTICLE GENERATION END*/
+
+	/*PARTICLE BEHAVIOUR*/
+	for (i = 0; i < PARTICLES_MAX; i++)
+	{
+		Particle* particle = gParticlesList + i;
+
+		if (particle->flag) 
+		{
+			/*Decrement particle values*/
+			particle->lifespan		-= g_dt;
+			particle->scale			-= g_dt / 3.f;
+			particle->transparency	-= g_dt;
+			particle->posCurr.y		+= particle->velCurr * g_dt;
+			particle->posCurr.x		+= pHero->face ? 1.f * g_dt : -1.f * g_dt;
+		}
+
+		/*Delete particle if the lifespan or scale becomes 0*/
+		if (particle->lifespan < 0 || 
+			particle->scale < 0) 
+			particle->flag = 0;
+
+	}
+	/*PARTICLE BEHAVIOUR END*/
+
+	if (FusedUpdate)
+	{
+		/*FUSED INSTANCE UPDATE*/
+		// one visit per instance, the rect-rect pass runs afterwards on the updated instances
+		for(k = 0; k < sGameObjInstAwakeNum; ++k)
+		{
+			inst = sGameObjInstAwakeList[k];
+
+			gameObjInstPhysics			(inst);
+			gameObjInstUpdatePosition	(inst);
+			gameObjInstGridCollision	(inst);
+			gameObjInstTransformUpdate	(inst);
+		} // FUSED INSTANCE UPDATE END
+	}
+	else
+	{
+		/*OBJECT PHYSICS*/
+		for(k = 0; k < sGameObjInstAwakeNum; ++k)
+			gameObjInstPhysics(sGameObjInstAwakeList[k]);
+
+		/*UPDATE POSITION*/
+		for(k = 0; k < sGameObjInstAwakeNum; ++k)
+			gameObjInstUpdatePosition(sGameObjInstAwakeList[k]);
+
+		/*GRID COLLISION*/
+		for(k = 0; k < sGameObjInstAwakeNum; ++k)
+			gameObjInstGridCollision(sGameObjInstAwakeList[k]);
+	}
+
+	/*RECT-RECT COLLISION*/
+	GameObjInstBucket	*pBucket;
+	bool				broadphaseBuilt = false;
+
+	if (GridBroadphase)
+	{
+		/*BROADPHASE*/
+		// the hero goes in first, so it is the first item of every pair it is in
+		BroadphaseClear(&sBroadphase);
+		broadphaseBuilt = BroadphaseAdd(&sBroadphase, hero, *gameObjInstBoundingBox(hero));
+
+		unsigned int type[] = { TYPE_OBJECT_ENEMY1, TYPE_OBJECT_COIN };
+		for (i = 0; i < 2 && broadphaseBuilt; ++i)
+		{
+			pBucket = sGameObjInstBucket + type[i];
+			for(k = 0; k < pBucket->num && broadphaseBuilt; ++k)
+			{
+				inst = pBucket->pList[k];
+
+				if (0 == (*gameObjInstFlag(inst) & FLAG_NON_COLLIDABLE))
+					broadphaseBuilt = BroadphaseAdd(&sBroadphase, inst, *gameObjInstBoundingBox(inst));
+			}
+		}
+	}
+
+	if (broadphaseBuilt)
+	{
+		unsigned int pairNum = BroadphaseFindPairs(&sBroadphase);
+
+		// one contact slot per pair, no contacts this frame if there is no memory for them
+		if (!ContactQueueBegin(&sContactQueue, pairNum))
+			pairNum = 0;
+
+		/*NARROWPHASE*/
+		rectRectNarrowphase(hero, 0, pairNum);
+	}
+	else
+	{
+		// no broadphase, or one that could not grow to hold every instance: the hero is tested against the buckets
+		GameObjInstBucket *pEnemy	= sGameObjInstBucket + TYPE_OBJECT_ENEMY1;
+		GameObjInstBucket *pCoin	= sGameObjInstBucket + TYPE_OBJECT_COIN;
+
+		// one contact slot per enemy and coin
+		unsigned int slot = 0, slotNum = pEnemy->num + pCoin->num;
+
+		if (!ContactQueueBegin(&sContactQueue, slotNum))
+			slotNum = 0;
+
+		/*COLLISION WITH ENEMY*/
+		for(k = 0; k < pEnemy->num && slot < slotNum; ++k, ++slot)
+		{
+			inst = pEnemy->pList[k];
+
+			if (0 == (*gameObjInstFlag(inst) & FLAG_NON_COLLIDABLE))
+				gameObjInstHeroContact(inst, slot);
+		}
+
+		/*COLLISION WITH COIN*/
+		// walk the bucket backwards, the order coins used to be collected in
+		for(k = pCoin->num; k > 0 && slot < slotNum; --k, ++slot)
+		{
+			inst = pCoin->pList[k - 1];
+
+			if (0 == (*gameObjInstFlag(inst) & FLAG_NON_COLLIDABLE))
+				gameObjInstHeroContact(inst, slot);
+		}
+	}
+
+	/*CONTACT RESPONSE*/
+	// the narrowphase only recorded contacts, instances are hit and destroyed here
+	unsigned int contactNum = ContactQueueEnd(&sContactQueue);
+
+	// the hero meets what it met first first, not in pair order
+	ContactQueueSortByTime(&sContactQueue);
+
+	for(k = 0; k < contactNum; ++k)
+		gameObjInstContactResponse(sContactQueue.pEvent[k], &result);
+	// RECT-RECT COLLISION END
+
+
+	/*OBJECT INSTANCE TRANSFORMATION MATRIX*/
+	if (FusedUpdate)
+	{
+		// the fused pass built the hero matrix before it could be respawned above
+		gameObjInstTransformUpdate(hero);
+	}
+	else
+	{
+		for(k = 0; k < sGameObjInstAwakeNum; ++k)
+			gameObjInstTransformUpdate(sGameObjInstAwakeList[k]);
+	} // OBJECT INSTANCE TRANSFORMATION MATRIX END
+
+	/*PARTICLE TRANSFORMATION MATRIX*/
+	for (i = 0; i < PARTICLES_MAX; ++i)
+	{
+		AEMtx33 scale, rot, trans;
+		Particle * particle = gParticlesList + i;
+
+		// skip non-active object
+		if (0 == (particle->flag))
+			continue;
+
+		AEMtx33Scale	(&scale,				particle->scale,		particle->scale		);
+		AEMtx33Rot		(&rot, 0);
+		AEMtx33Trans	(&trans,				particle->posCurr.x,	particle->posCurr.y	);
+		AEMtx33Concat	(&particle->transform,	&rot,					&scale				);
+		AEMtx33Concat	(&particle->transform,	&trans,					&particle->transform);
+	} // PARTICLE TRANSFORMATION MATRIX END
+
+	return result;
+}
+
+/******************************************************************************/
+/*!
+	Destroys all GameObjInst.
+*/
+/******************************************************************************/
+void PlatformSimFree(void)
+{
+	// kill all object in the list
+	while (gGameObjInstNum)
+		gameObjInstDestroy(gGameObjInstLiveList[gGameObjInstNum - 1]);
+
+	// restore the slot order so a restart spawns the level the same way
+	gameObjInstPoolReset();
+}
+
+/******************************************************************************/
+/*!
+	Turns a code path of the simulation on or off
+*/
+/******************************************************************************/
+void PlatformSimSetOption(PLATFORM_SIM_OPTION option, bool on)
+{
+	switch (option)
+	{
+	case PLATFORM_SIM_OPTION_FUSED_UPDATE:
+		FusedUpdate = on;
+		break;
+
+	case PLATFORM_SIM_OPTION_SLEEPING_COINS:
+		SleepingCoins = on;
+		break;
+
+	default:
+		break;
+	}
+}
+
+/******************************************************************************/
+/*!
+	Frees allocated memory
+*/
+/******************************************************************************/
+void PlatformSimUnload(void)
+{
+	/*********
+	Free the map data
+	*********/
+	FreeMapData();
+	BroadphaseFree(&sBroadphase);
+	ContactQueueFree(&sContactQueue);
+
+	for (unsigned int i = 0; i < sGameObjInstChunkNum; ++i)
+		free(gGameObjInstChunks[i]);
+
+	free(gGameObjInstChunks);
+	free(sGameObjInstFreeList);
+	free(gGameObjInstLiveList);
+	free(sGameObjInstAwakeList);
+	free(gGameObjInstHandleList);
+	free(sGameObjInstHandleFreeList);
+
+	for (unsigned int i = 0; i < TYPE_OBJECT_NUM; ++i)
+		free(sGameObjInstBucket[i].pList);
+	free(gGameObjList);
+	free(gParticlesList);
+}
+
+/******************************************************************************/
+/*!
+	Applies gravity and the state machine to an instance, coins do not move
+*/
+/******************************************************************************/
+void gameObjInstPhysics(unsigned int inst)
+{
+	unsigned int type = gameObjInst(inst)->pObject->type;
+
+	// skip coins
+	if (type == TYPE_OBJECT_COIN)
+		return;
+
+	AEVec2 *pVel = gameObjInstVel(inst);
+
+	// Apply gravity
+	pVel->y = GRAVITY * g_dt + pVel->y;
+
+	// Apply state machine
+	if (type == TYPE_OBJECT_ENEMY1) {
+		EnemyStateMachine(inst);
+	}
+}
+
+/******************************************************************************/
+/*!
+	Moves an instance by its velocity and updates its bounding box.
+	The grid probes only see a wall the instance sank less than a quarter
+	of its size into, a longer move is swept through the collision map
+	unless the distance field shows no wall within its reach.
+*/
+/******************************************************************************/
+void gameObjInstUpdatePosition(unsigned int inst)
+{
+	AEVec2	*pPos = gameObjInstPos(inst);
+	AEVec2	*pVel = gameObjInstVel(inst);
+	AABB	*pBox = gameObjInstBoundingBox(inst);
+	float	skin = gameObjInst(inst)->scale / 4.f; // how far in the side probes are
+
+	AEVec2	delta;
+	AEVec2Set(&delta, pVel->x * g_dt, pVel->y * g_dt);
+
+	// cells the box can touch are at most its half size plus the move plus one away from its cell
+	float	reach = gameObjInst(inst)->scale / 2.f + AEMax(fabsf(delta.x), fabsf(delta.y)) + 1.f;
+
+	if (!SweptGridCollision ||
+		(fabsf(delta.x) <= skin && fabsf(delta.y) <= skin) ||
+		(float)DistanceFieldGet(BinaryDistanceField, (int)floorf(pPos->x), (int)floorf(pPos->y)) > reach ||
+		!gameObjInstSweep(inst, delta, skin))
+	{
+		// Update position (movememnt)
+		pPos->x = pVel->x * g_dt + pPos->x;
+		pPos->y = pVel->y * g_dt + pPos->y;
+	}
+
+	AEVec2Set(&pBox->min, -BOUNDING_RECT_SIZE / 2.f + pPos->x,	-BOUNDING_RECT_SIZE / 2.f + pPos->y);
+	AEVec2Set(&pBox->max, BOUNDING_RECT_SIZE / 2.f + pPos->x,	BOUNDING_RECT_SIZE / 2.f + pPos->y	);
+}
+
+/******************************************************************************/
+/*!
+	Moves an instance by delta, stopping at the walls it would pass.
+	The first wall hit stops the move along its normal and the rest of the
+	move slides along the wall, which can hit a second wall.
+	The instance is then sunk into each wall it hit by what is left of the
+	move, no deeper than skin, so that the grid probes flag the contact and
+	snap it back the same way as a slow move.
+	Returns false, without moving the instance, if no wall cut the move
+	short. The plain move then ends in the same place.
+*/
+/******************************************************************************/
+bool gameObjInstSweep(unsigned int inst, AEVec2 delta, float skin)
+{
+	AEVec2	pos		= *gameObjInstPos(inst);
+	float	half	= gameObjInst(inst)->scale / 2.f;
+	bool	cut		= false;
+	AEVec2	sink, normal;
+	AABB	box;
+
+	AEVec2Zero(&sink);
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		AEVec2Set(&box.min, pos.x - half, pos.y - half);
+		AEVec2Set(&box.max, pos.x + half, pos.y + half);
+
+		float toi = CollisionMapSweep(BinaryCollisionMap, box, delta, &normal);
+
+		pos.x += delta.x * toi;
+		pos.y += delta.y * toi;
+
+		if (toi >= 1.f)
+			break;
+
+		// put the box exactly against the wall, so the slide does not catch on it
+		if (normal.x != 0.f)
+		{
+			pos.x	= floorf(pos.x - normal.x * half + 0.5f) + normal.x * half;
+			sink.x	= -normal.x * AEMin(fabsf(delta.x) * (1.f - toi), skin);
+			cut		|= fabsf(delta.x) * (1.f - toi) > skin;
+			delta.x	= 0.f;
+		}
+		else
+		{
+			pos.y	= floorf(pos.y - normal.y * half + 0.5f) + normal.y * half;
+			sink.y	= -normal.y * AEMin(fabsf(delta.y) * (1.f - toi), skin);
+			cut		|= fabsf(delta.y) * (1.f - toi) > skin;
+			delta.y	= 0.f;
+		}
+
+		delta.x *= 1.f - toi;
+		delta.y *= 1.f - toi;
+	}
+
+	if (!cut)
+		return false;
+
+	AEVec2Set(gameObjInstPos(inst), pos.x + sink.x, pos.y + sink.y);
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Checks an instance against the binary collision map and applies the response
+*/
+/******************************************************************************/
+void gameObjInstGridCollision(unsigned int inst)
+{
+	GameObjInst	*pInst	= gameObjInst(inst);
+	AEVec2		*pPos	= gameObjInstPos(inst);
+	AEVec2		*pVel	= gameObjInstVel(inst);
+
+	// Check collision
+	pInst->gridCollisionFlag = CheckInstanceBinaryMapCollision(pPos->x, pPos->y, pInst->scale, pInst->scale);
+
+	// Collision for top and bottom
+	if (pInst->gridCollisionFlag & COLLISION_BOTTOM || pInst->gridCollisionFlag & COLLISION_TOP) {
+		// Collision response
+		SnapToCell(&pPos->y);
+		pVel->y = 0;
+	}
+
+	// Collision for left and right
+	if (pInst->gridCollisionFlag & COLLISION_LEFT || pInst->gridCollisionFlag & COLLISION_RIGHT) {
+		// Update previous collison flag
+		pInst->gridCollisionFlagPrev = pInst->gridCollisionFlag;
+		// Collision response
+		SnapToCell(&pPos->x);
+		pVel->x = 0;
+	}
+}
+
+/******************************************************************************/
+/*!
+	Rebuilds the drawing matrix of an instance
+*/
+/******************************************************************************/
+void gameObjInstTransformUpdate(unsigned int inst)
+{
+	AEMtx33 scale, rot, trans;
+
+	GameObjInst	*pInst		= gameObjInst(inst);
+	AEVec2		*pPos		= gameObjInstPos(inst);
+	AEMtx33		*pTransform	= gameObjInstTransform(inst);
+
+	// TRANSFORMATION MATRIX
+	AEMtx33Scale	(&scale,	pInst->scale,	pInst->scale	);
+	AEMtx33Rot		(&rot,		pInst->dirCurr					);
+	AEMtx33Trans	(&trans,	pPos->x,		pPos->y			);
+
+	AEMtx33Concat	(pTransform, &rot,		&scale		);
+	AEMtx33Concat	(pTransform, &trans,	pTransform	);
+}
+
+/******************************************************************************/
+/*!
+	Tests the hero against an enemy or a coin and records a contact in the
+	slot if they touch. Nothing is changed, so slots can be tested in any
+	order or at the same time.
+*/
+/******************************************************************************/
+void gameObjInstHeroContact(unsigned int inst, unsigned int slot)
+{
+	unsigned int	hero		= gameObjInstResolve(HeroInstance);
+	AABB			*pHeroBox	= gameObjInstBoundingBox(hero);
+	AABB			*pBox		= gameObjInstBoundingBox(inst);
+	AEVec2			*pHeroVel	= gameObjInstVel(hero);
+	AEVec2			*pVel		= gameObjInstVel(inst);
+
+	if (!CollisionIntersection_RectRect({ pBox->min, pBox->max },			*pVel,
+										{ pHeroBox->min, pHeroBox->max },	*pHeroVel))
+		return;
+
+	// sweep both boxes again from where this frame moved them from, to find when in the frame they met
+	AABB			heroStart, start;
+	RectRectContact	contact = { 0.f, 0.f, { 0.f, 0.f } };
+
+	AEVec2Set(&heroStart.min,	pHeroBox->min.x - pHeroVel->x * g_dt,	pHeroBox->min.y - pHeroVel->y * g_dt);
+	AEVec2Set(&heroStart.max,	pHeroBox->max.x - pHeroVel->x * g_dt,	pHeroBox->max.y - pHeroVel->y * g_dt);
+	AEVec2Set(&start.min,		pBox->min.x - pVel->x * g_dt,			pBox->min.y - pVel->y * g_dt		);
+	AEVec2Set(&start.max,		pBox->max.x - pVel->x * g_dt,			pBox->max.y - pVel->y * g_dt		);
+
+	// a wall can have stopped either box during the move, the contact is then taken as it is now
+	if (!CollisionIntersection_RectRectSwept(heroStart, *pHeroVel, start, *pVel, &contact))
+		CollisionIntersection_RectRectSwept(*pHeroBox, *pHeroVel, *pBox, *pVel, &contact);
+
+	ContactQueueWrite(&sContactQueue, slot, HeroInstance, gameObjInstHandle(inst), contact.tFirst, contact.normal);
+}
+
+/******************************************************************************/
+/*!
+	Tests the broadphase pairs [begin, end), pair k writes contact slot k.
+	Only the hero reacts to a collision, enemies and coins overlapping each
+	other are skipped.
+*/
+/******************************************************************************/
+void rectRectNarrowphase(unsigned int hero, unsigned int begin, unsigned int end)
+{
+	for (unsigned int k = begin; k < end; ++k)
+	{
+		BroadphasePair *pPair = sBroadphase.pPair + k;
+
+		if (pPair->a == hero)
+			gameObjInstHeroContact(pPair->b, k);
+	}
+}
+
+/******************************************************************************/
+/*!
+	Applies a contact of the hero with an enemy or a coin.
+	Touching an enemy costs a life, touching a coin collects it.
+*/
+/******************************************************************************/
+void gameObjInstContactResponse(const ContactEvent &contact, PLATFORM_SIM_RESULT *pResult)
+{
+	// the hero is hit as long as it touches, leaving has no effect
+	if (CONTACT_EXIT == contact.type || HeroInstance != contact.a)
+		return;
+
+	unsigned int hero	= gameObjInstResolve(HeroInstance);
+	unsigned int inst	= gameObjInstResolve(contact.b);
+
+	/*COLLISiON RESPONSE*/
+	if (gameObjInst(inst)->pObject->type == TYPE_OBJECT_ENEMY1)
+	{
+		HeroLives--; // Decrement lives
+
+		/*IF HERO STILL HAVE LIVES, RESET POSITION, IF NOT RESTART LEVEL*/
+		if (!HeroLives)
+			*pResult = PLATFORM_SIM_RESULT_LOST;
+		else
+			AEVec2Set(gameObjInstPos(hero), (f32)Hero_Initial_X + 0.5f, (f32)Hero_Initial_Y + 0.5f);
+	}
+	else
+	{
+		TotalCoins--; // Decrement coin count
+		gameObjInstDestroy(inst); // Destroy coin instance
+		if (0 == TotalCoins) {
+			// all coins collected, the level is done
+			*pResult = PLATFORM_SIM_RESULT_CLEARED;
+		}
+	}
+}
+
+/******************************************************************************/
+/*!
+	Marks every instance slot as unused and refills the free slot stack
+*/
+/******************************************************************************/
+void gameObjInstPoolReset(void)
+{
+	// push in reverse so that slot 0 is on top and handed out first
+	sGameObjInstFreeNum = 0;
+	for (unsigned int i = sGameObjInstChunkNum * GAME_OBJ_INST_CHUNK_SIZE; i > 0; --i)
+		sGameObjInstFreeList[sGameObjInstFreeNum++] = i - 1;
+
+	sGameObjInstHandleFreeNum = 0;
+	for (unsigned int i = gGameObjInstHandleNum; i > 0; --i)
+		sGameObjInstHandleFreeList[sGameObjInstHandleFreeNum++] = i - 1;
+
+	gGameObjInstNum			= 0;
+	sGameObjInstAwakeNum	= 0;
+	sGameObjInstPoolDirty	= false;
+
+	for (unsigned int i = 0; i < TYPE_OBJECT_NUM; ++i)
+		sGameObjInstBucket[i].num = 0;
+}
+
+/******************************************************************************/
+/*!
+	Adds one chunk of unused slots to the instance pool.
+	Only the chunk table and the slot lists are reallocated, existing
+	chunks stay where they are.
+*/
+/******************************************************************************/
+bool gameObjInstPoolGrow(void)
+{
+	unsigned int capacity = (sGameObjInstChunkNum + 1) * GAME_OBJ_INST_CHUNK_SIZE;
+
+	GameObjInstChunk **ppChunks = (GameObjInstChunk**)realloc(gGameObjInstChunks, (sGameObjInstChunkNum + 1) * sizeof(GameObjInstChunk*));
+	if (0 == ppChunks)
+		return false;
+	gGameObjInstChunks = ppChunks;
+
+	unsigned int *pFreeList = (unsigned int*)realloc(sGameObjInstFreeList, capacity * sizeof(unsigned int));
+	if (0 == pFreeList)
+		return false;
+	sGameObjInstFreeList = pFreeList;
+
+	unsigned int *pLiveList = (unsigned int*)realloc(gGameObjInstLiveList, capacity * sizeof(unsigned int));
+	if (0 == pLiveList)
+		return false;
+	gGameObjInstLiveList = pLiveList;
+
+	unsigned int *pAwakeList = (unsigned int*)realloc(sGameObjInstAwakeList, capacity * sizeof(unsigned int));
+	if (0 == pAwakeList)
+		return false;
+	sGameObjInstAwakeList = pAwakeList;
+
+	GameObjInstChunk *pChunk = (GameObjInstChunk*)calloc(1, sizeof(GameObjInstChunk));
+	if (0 == pChunk)
+		return false;
+	gGameObjInstChunks[sGameObjInstChunkNum++] = pChunk;
+
+	// push in reverse so that the lowest new slot is handed out first
+	for (unsigned int i = capacity; i > capacity - GAME_OBJ_INST_CHUNK_SIZE; --i)
+		sGameObjInstFreeList[sGameObjInstFreeNum++] = i - 1;
+
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Moves every active instance into the lowest slots so that the live
+	instances are contiguous, then releases the chunks left empty at the end.
+	Handles stay valid, instance slots do not.
+*/
+/******************************************************************************/
+void gameObjInstPoolCompact(void)
+{
+	unsigned int lo = 0, hi = sGameObjInstChunkNum * GAME_OBJ_INST_CHUNK_SIZE;
+
+	for (;;)
+	{
+		// lowest unused slot and highest used slot
+		while (lo < hi && *gameObjInstFlag(lo))
+			++lo;
+		while (lo < hi && 0 == *gameObjInstFlag(hi - 1))
+			--hi;
+		if (lo >= hi)
+			break;
+
+		unsigned int		src	= --hi;
+		unsigned int		dst	= lo++;
+		GameObjInstChunk	*pSrc = gameObjInstChunk(src), *pDst = gameObjInstChunk(dst);
+		unsigned int		s	= src & GAME_OBJ_INST_CHUNK_MASK;
+		unsigned int		d	= dst & GAME_OBJ_INST_CHUNK_MASK;
+
+		pDst->inst[d]			= pSrc->inst[s];
+		pDst->flag[d]			= pSrc->flag[s];
+		pDst->posCurr[d]		= pSrc->posCurr[s];
+		pDst->velCurr[d]		= pSrc->velCurr[s];
+		pDst->boundingBox[d]	= pSrc->boundingBox[s];
+		pDst->transform[d]		= pSrc->transform[s];
+		pDst->state[d]			= pSrc->state[s];
+		pDst->handle[d]			= pSrc->handle[s];
+		pDst->awakePos[d]		= pSrc->awakePos[s];
+		pSrc->flag[s]			= 0;
+
+		// repoint the handle at the new slot
+		gGameObjInstHandleList[pDst->handle[d]].inst = dst;
+	}
+
+	// release the chunks that are now empty, the first one is kept
+	unsigned int chunkNum = (gGameObjInstNum + GAME_OBJ_INST_CHUNK_MASK) >> GAME_OBJ_INST_CHUNK_SHIFT;
+	if (0 == chunkNum)
+		chunkNum = 1;
+
+	while (sGameObjInstChunkNum > chunkNum)
+		free(gGameObjInstChunks[--sGameObjInstChunkNum]);
+
+	// the live instances are now slots 0 to gGameObjInstNum - 1, in order
+	for (unsigned int i = 0; i < TYPE_OBJECT_NUM; ++i)
+		sGameObjInstBucket[i].num = 0;
+
+	sGameObjInstAwakeNum = 0;
+
+	for (unsigned int inst = 0; inst < gGameObjInstNum; ++inst)
+	{
+		GameObjInstChunk	*pChunk		= gameObjInstChunk(inst);
+		GameObjInstBucket	*pBucket	= sGameObjInstBucket + gameObjInst(inst)->pObject->type;
+
+		pChunk->livePos[inst & GAME_OBJ_INST_CHUNK_MASK]	= inst;
+		gGameObjInstLiveList[inst]							= inst;
+
+		pChunk->bucketPos[inst & GAME_OBJ_INST_CHUNK_MASK]	= pBucket->num;
+		pBucket->pList[pBucket->num++]						= inst;
+
+		if (GAME_OBJ_INST_NONE != pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK])
+		{
+			pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK]	= sGameObjInstAwakeNum;
+			sGameObjInstAwakeList[sGameObjInstAwakeNum++]		= inst;
+		}
+	}
+
+	// push in reverse so that the lowest unused slot is handed out first
+	sGameObjInstFreeNum = 0;
+	for (unsigned int i = sGameObjInstChunkNum * GAME_OBJ_INST_CHUNK_SIZE; i > gGameObjInstNum; --i)
+		sGameObjInstFreeList[sGameObjInstFreeNum++] = i - 1;
+
+	sGameObjInstPoolDirty = false;
+}
+
+/******************************************************************************/
+/*!
+	Adds one chunk worth of unused handle slots
+*/
+/******************************************************************************/
+bool gameObjInstHandleGrow(void)
+{
+	unsigned int num = gGameObjInstHandleNum + GAME_OBJ_INST_CHUNK_SIZE;
+
+	// the top handle slot would collide with GAME_OBJ_INST_NONE
+	if (num > GAME_OBJ_INST_HANDLE_INDEX_MASK)
+		return false;
+
+	GameObjInstHandleSlot *pList = (GameObjInstHandleSlot*)realloc(gGameObjInstHandleList, num * sizeof(GameObjInstHandleSlot));
+	if (0 == pList)
+		return false;
+	gGameObjInstHandleList = pList;
+
+	unsigned int *pFreeList = (unsigned int*)realloc(sGameObjInstHandleFreeList, num * sizeof(unsigned int));
+	if (0 == pFreeList)
+		return false;
+	sGameObjInstHandleFreeList = pFreeList;
+
+	// push in reverse so that the lowest new handle slot is handed out first
+	for (unsigned int i = num; i > gGameObjInstHandleNum; --i)
+	{
+		gGameObjInstHandleList[i - 1].generation		= 0;
+		sGameObjInstHandleFreeList[sGameObjInstHandleFreeNum++]	= i - 1;
+	}
+
+	gGameObjInstHandleNum = num;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Doubles the length of a type bucket
+*/
+/******************************************************************************/
+bool gameObjInstBucketGrow(GameObjInstBucket* pBucket)
+{
+	unsigned int max = pBucket->max ? pBucket->max * 2 : GAME_OBJ_INST_CHUNK_SIZE;
+
+	unsigned int *pList = (unsigned int*)realloc(pBucket->pList, max * sizeof(unsigned int));
+	if (0 == pList)
+		return false;
+
+	pBucket->pList	= pList;
+	pBucket->max	= max;
+	return true;
+}
+
+/******************************************************************************/
+/*!
+	Creates object instance
+*/
+/******************************************************************************/
+GameObjInstHandle gameObjInstCreate(unsigned int type, float scale, 
+							   AEVec2* pPos, AEVec2* pVel, 
+							   float dir, enum STATE startState)
+{
+	AEVec2 zero;
+	AEVec2Zero(&zero);
+
+	AE_ASSERT_PARM(type < gGameObjNum);
+
+	// every slot is in use, add another chunk
+	if (0 == sGameObjInstFreeNum && !gameObjInstPoolGrow())
+		return GAME_OBJ_INST_NONE;
+
+	// make room in the bucket of its type
+	GameObjInstBucket *pBucket = sGameObjInstBucket + gGameObjList[type].type;
+	if (pBucket->num == pBucket->max && !gameObjInstBucketGrow(pBucket))
+		return GAME_OBJ_INST_NONE;
+
+	// every handle slot is in use
+	if (0 == sGameObjInstHandleFreeNum && !gameObjInstHandleGrow())
+		return GAME_OBJ_INST_NONE;
+
+	// pop a non-used object instance off the free stack
+	unsigned int		inst	= sGameObjInstFreeList[--sGameObjInstFreeNum];
+	GameObjInst			*pInst	= gameObjInst(inst);
+	GameObjInstState	*pState	= gameObjInstState(inst);
+
+	*gameObjInstFlag(inst)		 = FLAG_ACTIVE | FLAG_VISIBLE;
+	*gameObjInstPos(inst)		 = pPos ? *pPos : zero;
+	*gameObjInstVel(inst)		 = pVel ? *pVel : zero;
+
+	pInst->pObject				 = gGameObjList + type;
+	pInst->scale				 = scale;
+	pInst->dirCurr				 = dir;
+	pInst->face					 = FACE_LEFT;
+	pInst->pUserData			 = 0;
+	pInst->gridCollisionFlag	 = 0;
+	pInst->gridCollisionFlagPrev = 0;
+
+	pState->state				 = startState;
+	pState->innerState			 = INNER_STATE_ON_ENTER;
+	pState->counter				 = 0;
+
+	GameObjInstChunk *pChunk = gameObjInstChunk(inst);
+
+	// append to the live list
+	pChunk->livePos[inst & GAME_OBJ_INST_CHUNK_MASK]	= gGameObjInstNum;
+	gGameObjInstLiveList[gGameObjInstNum++]				= inst;
+
+	// append to the bucket of its type
+	pChunk->bucketPos[inst & GAME_OBJ_INST_CHUNK_MASK]	= pBucket->num;
+	pBucket->pList[pBucket->num++]						= inst;
+
+	// new instances are awake
+	pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK]	= sGameObjInstAwakeNum;
+	sGameObjInstAwakeList[sGameObjInstAwakeNum++]		= inst;
+
+	// point a handle slot at the instance
+	unsigned int			handle	= sGameObjInstHandleFreeList[--sGameObjInstHandleFreeNum];
+	GameObjInstHandleSlot	*pSlot	= gGameObjInstHandleList + handle;
+
+	pSlot->inst											= inst;
+	pChunk->handle[inst & GAME_OBJ_INST_CHUNK_MASK]		= handle;
+
+	// return the handle of the newly created instance
+	return (pSlot->generation << GAME_OBJ_INST_HANDLE_INDEX_BITS) | handle;
+}
+
+/******************************************************************************/
+/*!
+	Destroys object instance
+*/
+/******************************************************************************/
+void gameObjInstDestroy(unsigned int inst)
+{
+	// if instance is destroyed before, just return
+	if (*gameObjInstFlag(inst) == 0)
+		return;
+
+	// zero out the flag
+	*gameObjInstFlag(inst) = 0;
+
+	// hand the slot back to the free stack
+	sGameObjInstFreeList[sGameObjInstFreeNum++] = inst;
+
+	// swap-remove from the live list
+	unsigned int last	= gGameObjInstLiveList[--gGameObjInstNum];
+	unsigned int pos	= gameObjInstChunk(inst)->livePos[inst & GAME_OBJ_INST_CHUNK_MASK];
+
+	gGameObjInstLiveList[pos]										= last;
+	gameObjInstChunk(last)->livePos[last & GAME_OBJ_INST_CHUNK_MASK]	= pos;
+
+	// swap-remove from the bucket of its type
+	GameObjInstBucket *pBucket = sGameObjInstBucket + gameObjInst(inst)->pObject->type;
+	last	= pBucket->pList[--pBucket->num];
+	pos		= gameObjInstChunk(inst)->bucketPos[inst & GAME_OBJ_INST_CHUNK_MASK];
+
+	pBucket->pList[pos]													= last;
+	gameObjInstChunk(last)->bucketPos[last & GAME_OBJ_INST_CHUNK_MASK]	= pos;
+
+	// release the handle slot, old handles to it no longer match its generation
+	unsigned int			handle	= gameObjInstChunk(inst)->handle[inst & GAME_OBJ_INST_CHUNK_MASK];
+	GameObjInstHandleSlot	*pSlot	= gGameObjInstHandleList + handle;
+
+	pSlot->generation = (pSlot->generation + 1) & GAME_OBJ_INST_HANDLE_GEN_MASK;
+	sGameObjInstHandleFreeList[sGameObjInstHandleFreeNum++] = handle;
+
+	if (GAME_OBJ_INST_NONE != gameObjInstChunk(inst)->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK])
+	{
+		// swap-remove from the awake list
+		last	= sGameObjInstAwakeList[--sGameObjInstAwakeNum];
+		pos		= gameObjInstChunk(inst)->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK];
+
+		sGameObjInstAwakeList[pos]											= last;
+		gameObjInstChunk(last)->awakePos[last & GAME_OBJ_INST_CHUNK_MASK]	= pos;
+	}
+
+	// compacting visits every slot, so it waits until the unused slots fill two chunks and one of them can be released.
+	// After a compaction fewer than a chunk are unused, a chunk of destroys has to happen before the next one.
+	if (sGameObjInstChunkNum * GAME_OBJ_INST_CHUNK_SIZE - gGameObjInstNum >= 2 * GAME_OBJ_INST_CHUNK_SIZE)
+		sGameObjInstPoolDirty = true;
+}
+
+/******************************************************************************/
+/*!
+	Bytes held by the instance pool: the chunks, the slot and handle
+	lists and the type buckets
+*/
+/******************************************************************************/
+size_t gameObjInstPoolMemory(void)
+{
+	size_t capacity	= sGameObjInstChunkNum * GAME_OBJ_INST_CHUNK_SIZE;
+	size_t memory	=	sGameObjInstChunkNum * (sizeof(GameObjInstChunk) + sizeof(GameObjInstChunk*)) +	// chunks
+						capacity * 3 * sizeof(unsigned int) +											// free, live and awake lists
+						gGameObjInstHandleNum * (sizeof(GameObjInstHandleSlot) + sizeof(unsigned int));	// handles
+
+	for (unsigned int i = 0; i < TYPE_OBJECT_NUM; ++i)
+		memory += sGameObjInstBucket[i].max * sizeof(unsigned int);
+
+	return memory;
+}
+
+/******************************************************************************/
+/*!
+	Stops an instance and takes it out of the update passes.
+	Its bounding box, grid collision flags and matrix are brought up to
+	date one last time and kept until it is woken.
+*/
+/******************************************************************************/
+void gameObjInstSleep(unsigned int inst)
+{
+	GameObjInstChunk	*pChunk	= gameObjInstChunk(inst);
+	unsigned int		pos		= pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK];
+
+	// already asleep
+	if (GAME_OBJ_INST_NONE == pos)
+		return;
+
+	AEVec2Zero					(gameObjInstVel(inst));
+	gameObjInstUpdatePosition	(inst);
+	gameObjInstGridCollision	(inst);
+	gameObjInstTransformUpdate	(inst);
+
+	// swap-remove from the awake list
+	unsigned int last = sGameObjInstAwakeList[--sGameObjInstAwakeNum];
+
+	sGameObjInstAwakeList[pos]											= last;
+	gameObjInstChunk(last)->awakePos[last & GAME_OBJ_INST_CHUNK_MASK]	= pos;
+	pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK]					= GAME_OBJ_INST_NONE;
+}
+
+/******************************************************************************/
+/*!
+	Puts a sleeping instance back into the update passes
+*/
+/******************************************************************************/
+void gameObjInstWake(unsigned int inst)
+{
+	GameObjInstChunk *pChunk = gameObjInstChunk(inst);
+
+	// already awake
+	if (GAME_OBJ_INST_NONE != pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK])
+		return;
+
+	pChunk->awakePos[inst & GAME_OBJ_INST_CHUNK_MASK]	= sGameObjInstAwakeNum;
+	sGameObjInstAwakeList[sGameObjInstAwakeNum++]		= inst;
+}
+
+/******************************************************************************/
+/*!
+	Gets cell value from binary collision data
+*/
+/******************************************************************************/
+int GetCellValue(int X, int Y)
+{
+	return CollisionMapGet(BinaryCollisionMap, X, Y);
+}
+
+/******************************************************************************/
+/*!
+	Changes a cell of the map and keeps the collision map, the distance
+	field and the merged rectangles in step with it
+*/
+/******************************************************************************/
+void SetCellValue(int X, int Y, int value)
+{
+	if (X < 0 || X >= BINARY_MAP_WIDTH ||
+		Y < 0 || Y >= BINARY_MAP_HEIGHT)
+		return;
+
+	TileGridSet(&MapData, X, Y, value);
+
+	CollisionMapSet		(&BinaryCollisionMap, X, Y, value == TYPE_OBJECT_COLLISION);
+	DistanceFieldUpdate	(&BinaryDistanceField, BinaryCollisionMap, X, Y);
+
+	// only the rectangle around the cell changes, the whole map is merged again if the list cannot grow
+	if (!ColliderListSetCell(&BinaryColliderList, X, Y, value == TYPE_OBJECT_COLLISION))
+		ColliderListBuild(&BinaryColliderList, BinaryCollisionMap);
+}
+
+/******************************************************************************/
+/*!
+	Checks collision of object based on the binary collision map.
+	Both cells of a side are always read and or-ed, so the probes are bit
+	tests without branches.
+*/
+/******************************************************************************/
+int CheckInstanceBinaryMapCollision(float PosX, float PosY, float scaleX, float scaleY)
+{
+	int flag{};
+
+	float x1, y1, x2, y2;
+	/*RIGHT*/
+	x1 = PosX + scaleX / 2.f;
+	y1 = PosY + scaleY / 4.f;
+
+	x2 = PosX + scaleX / 2.f;
+	y2 = PosY - scaleY / 4.f;
+	flag |= (GetCellValue((int)x1, (int)y1) | GetCellValue((int)x2, (int)y2)) * COLLISION_RIGHT;
+
+	/*LEFT*/
+	x1 = PosX - scaleX / 2.f;
+	y1 = PosY + scaleY / 4.f;
+
+	x2 = PosX - scaleX / 2.f;
+	y2 = PosY - scaleY / 4.f;
+	flag |= (GetCellValue((int)x1, (int)y1) | GetCellValue((int)x2, (int)y2)) * COLLISION_LEFT;
+
+	/*TOP*/
+	x1 = PosX + scaleX / 4.f;
+	y1 = PosY + scaleY / 2.f;
+
+	x2 = PosX - scaleX / 4.f;
+	y2 = PosY + scaleY / 2.f;
+	flag |= (GetCellValue((int)x1, (int)y1) | GetCellValue((int)x2, (int)y2)) * COLLISION_TOP;
+
+	/*BOTTOM*/
+	x1 = PosX + scaleX / 4.f;
+	y1 = PosY - scaleY / 2.f;
+
+	x2 = PosX - scaleX / 4.f;
+	y2 = PosY - scaleY / 2.f;
+	flag |= (GetCellValue((int)x1, (int)y1) | GetCellValue((int)x2, (int)y2)) * COLLISION_BOTTOM;
+
+	return flag;
+}
+
+/******************************************************************************/
+/*!
+	Snaps to cell
+*/
+/******************************************************************************/
+void SnapToCell(float *Coordinate)
+{
+	*Coordinate = (float)((int)(*Coordinate) + 0.5f);
+}
+
+/******************************************************************************/
+/*!
+	Builds the tables a level keeps next to its tile grid: the collision
+	map, the distance field and the merged rectangles
+*/
+/******************************************************************************/
+static int BuildMapTables(LevelMap *pMap)
+{
+	const TileGrid &grid = pMap->grid;
+
+	/*ONE BIT PER COLLISION CELL*/
+	if (!CollisionMapInit(&pMap->collision, grid.width, grid.height))
+		return 0;
+
+	for (int y = 0; y < grid.height; y++)
+		for (int x = 0; x < grid.width; x++)
+			CollisionMapSet(&pMap->collision, x, y, TileGridGet(grid, x, y) == TYPE_OBJECT_COLLISION);
+
+	/*DISTANCE TO THE NEAREST COLLISION CELL AND FREE RUNS*/
+	if (!DistanceFieldInit(&pMap->distance, pMap->collision))
+		return 0;
+
+	/*COLLISION CELLS MERGED INTO RECTANGLES*/
+	if (!ColliderListBuild(&pMap->colliders, pMap->collision))
+		return 0;
+
+	return 1;
+}
+
+/******************************************************************************/
+/*!
+	Reads the next integer of a text level and moves past it. Anything
+	that is not part of a number is skipped, 0 at the end of the text.
+	Only the first 9 digits are kept, so a longer number still fits in an
+	int and is read as a value no level uses.
+*/
+/******************************************************************************/
+static inline int ScanInt(const char **ppNext, const char *pEnd)
+{
+	const char *pChar = *ppNext;
+
+	while (pChar < pEnd && (unsigned int)(*pChar - '0') > 9 && *pChar != '-')
+		++pChar;
+
+	bool negative = pChar < pEnd && *pChar == '-';
+	int value = 0, digits = 0;
+
+	for (pChar += negative; pChar < pEnd && (unsigned int)(*pChar - '0') <= 9; ++pChar)
+		if (digits++ < 9)
+			value = value * 10 + (*pChar - '0');
+
+	*ppNext = pChar;
+
+	return negative ? -value : value;
+}
+
+/******************************************************************************/
+/*!
+	Reads a text level into the tile grid in one pass over the file.
+	Each line of the file is a row of the grid.
+*/
+/******************************************************************************/
+static int ImportMapDataFromText(LevelMap *pMap, const char *FileName)
+{
+	/*THE WHOLE FILE IN ONE BUFFER*/
+	std::ifstream stream{ FileName, std::ios::binary | std::ios::ate };
+	if (!stream.good())
+		return 0;
+
+	size_t	size	= (size_t)stream.tellg();
+	char	*pText	= (char*)malloc(size ? size : 1);
+
+	if (0 == pText)
+		return 0;
+
+	if (!stream.seekg(0).read(pText, (std::streamsize)size))
+	{
+		free(pText);
+		return 0;
+	}
+
+	const char *pNext	= pText;
+	const char *pEnd	= pText + size;
+
+	// the Width and Height labels are skipped like spaces
+	int width	= ScanInt(&pNext, pEnd);
+	int height	= ScanInt(&pNext, pEnd);
+
+	if (width < 0 || height < 0 || !TileGridInit(&pMap->grid, width, height))
+	{
+		free(pText);
+		return 0;
+	}
+
+	// the rows of the file are the rows of the grid, the values go straight into place
+	unsigned char	*pCell	= pMap->grid.pCells;
+	bool			valid	= true;
+
+	for (size_t i = 0, cellNum = (size_t)width * height; i < cellNum; ++i)
+	{
+		int value = ScanInt(&pNext, pEnd);
+
+		// a cell holds an object type, anything else would be stored as some other type
+		valid		= valid && (unsigned int)value < TYPE_OBJECT_NUM;
+		pCell[i]	= (unsigned char)value;
+	}
+
+	free(pText);
+
+	if (!valid)
+		return 0;
+
+	/*OBJECTS BY COLUMN AND ROW*/
+	unsigned int	spawnNum	= LevelFileSpawns(pMap->grid.pCells, width, height, 0);
+	LevelSpawn		*pSpawn		= (LevelSpawn*)malloc((spawnNum ? spawnNum : 1) * sizeof(LevelSpawn));
+
+	if (0 == pSpawn)
+		return 0;
+
+	pMap->pSpawn	= pSpawn;
+	pMap->spawnNum	= LevelFileSpawns(pMap->grid.pCells, width, height, pSpawn);
+
+	return 1;
+}
+
+/******************************************************************************/
+/*!
+	Reads a level into pMap, which must be zeroed. Only pMap is touched,
+	so levels can be read on any thread. On failure pMap holds what was
+	read so far and still has to be freed.
+*/
+/******************************************************************************/
+static int LevelMapImport(LevelMap *pMap, const char *FileName)
+{
+	if (LevelFileOpen(&pMap->file, FileName))
+	{
+		/*BINARY LEVEL, USED IN PLACE*/
+		pMap->grid.pCells	= pMap->file.pCells;
+		pMap->grid.width	= (int)pMap->file.pHeader->width;
+		pMap->grid.height	= (int)pMap->file.pHeader->height;
+		pMap->pSpawn		= pMap->file.pSpawn;
+		pMap->spawnNum		= pMap->file.pHeader->spawnNum;
+	}
+	else if (!ImportMapDataFromText(pMap, FileName))
+		return 0;
+
+	return BuildMapTables(pMap);
+}
+
+/******************************************************************************/
+/*!
+	Frees a level read by LevelMapImport
+*/
+/******************************************************************************/
+static void LevelMapFree(LevelMap *pMap)
+{
+	// a text level owns its grid and spawn list, a binary level's are in the mapped file
+	if (0 == pMap->file.pHeader)
+	{
+		TileGridFree(&pMap->grid);
+		free((void*)pMap->pSpawn);
+	}
+
+	LevelFileClose(&pMap->file);
+	CollisionMapFree(&pMap->collision);
+	DistanceFieldFree(&pMap->distance);
+	ColliderListFree(&pMap->colliders);
+
+	memset(pMap, 0, sizeof(LevelMap));
+}
+
+/******************************************************************************/
+/*!
+	Makes a level the current map, or takes the current map back out
+*/
+/******************************************************************************/
+static void LevelMapUse(const LevelMap &map)
+{
+	MapData				= map.grid;
+	BinaryCollisionMap	= map.collision;
+	BinaryColliderList	= map.colliders;
+	BinaryDistanceField	= map.distance;
+	sLevelFile			= map.file;
+	sSpawnList			= map.pSpawn;
+	sSpawnNum			= map.spawnNum;
+	BINARY_MAP_WIDTH	= map.grid.width;
+	BINARY_MAP_HEIGHT	= map.grid.height;
+}
+
+static void LevelMapCurrent(LevelMap *pMap)
+{
+	pMap->grid		= MapData;
+	pMap->collision	= BinaryCollisionMap;
+	pMap->colliders	= BinaryColliderList;
+	pMap->distance	= BinaryDistanceField;
+	pMap->file		= sLevelFile;
+	pMap->pSpawn	= sSpawnList;
+	pMap->spawnNum	= sSpawnNum;
+}
+
+/******************************************************************************/
+/*!	
+	Imports data from file path and filps the data along the x and y axis.
+	A binary level file is mapped and its cells become the tile grid as
+	they are, anything else is read as a text level.
+*/
+/******************************************************************************/
+int ImportMapDataFromFile(const char *FileName)
+{
+	LevelMap map;
+	memset(&map, 0, sizeof(LevelMap));
+
+	// even a level that failed to load becomes the current map, FreeMapData frees it
+	int loaded = LevelMapImport(&map, FileName);
+
+	LevelMapUse(map);
+
+	return loaded;
+}
+
+/******************************************************************************/
+/*!
+	Writes the imported map as a binary level file
+*/
+/******************************************************************************/
+int ExportMapDataToFile(const char *FileName)
+{
+	return LevelFileWrite(FileName, MapData.pCells, MapData.width, MapData.height) ? 1 : 0;
+}
+
+/******************************************************************************/
+/*!
+	Deletes allocated memory for the maps
+*/
+/******************************************************************************/
+void FreeMapData(void)
+{
+	LevelMap map;
+
+	LevelMapCurrent(&map);
+	LevelMapFree(&map);
+	LevelMapUse(map);
+}
+
+/******************************************************************************/
+/*!
+	Reads a level on a preload thread
+*/
+/******************************************************************************/
+static void LevelPreloadRun(LevelPreload *pPreload)
+{
+	pPreload->result = LevelMapImport(&pPreload->map, pPreload->fileName.c_str());
+}
+
+/******************************************************************************/
+/*!
+	Starts reading a level on a background thread, so that loading it
+	later only has to take it over. Does nothing if the level is already
+	being read or if every preload slot is in use.
+*/
+/******************************************************************************/
+void PlatformSimPreload(const char *FileName)
+{
+	LevelPreload *pFree = 0;
+
+	for (unsigned int i = 0; i < LEVEL_PRELOAD_MAX; ++i)
+	{
+		if (sLevelPreload[i].fileName == FileName)
+			return;
+
+		if (!pFree && sLevelPreload[i].fileName.empty())
+			pFree = sLevelPreload + i;
+	}
+
+	if (!pFree)
+		return;
+
+	memset(&pFree->map, 0, sizeof(LevelMap));
+	pFree->fileName	= FileName;
+	pFree->result	= 0;
+	pFree->thread	= std::thread(LevelPreloadRun, pFree);
+}
+
+/******************************************************************************/
+/*!
+	Makes a preloaded level the current map. Waits for the preload thread
+	if it has not finished yet. Returns 0 if the level was not preloaded
+	or could not be read.
+*/
+/******************************************************************************/
+static int LevelPreloadTake(const char *FileName)
+{
+	for (unsigned int i = 0; i < LEVEL_PRELOAD_MAX; ++i)
+	{
+		LevelPreload *pPreload = sLevelPreload + i;
+
+		if (pPreload->fileName != FileName)
+			continue;
+
+		pPreload->thread.join();
+		pPreload->fileName.clear();
+
+		if (!pPreload->result)
+		{
+			LevelMapFree(&pPreload->map);
+			return 0;
+		}
+
+		LevelMapUse(pPreload->map);
+		return 1;
+	}
+
+	return 0;
+}
+
+/******************************************************************************/
+/*!
+	Waits for the preload threads and frees the levels nobody took over
+*/
+/******************************************************************************/
+void PlatformSimPreloadFree(void)
+{
+	for (unsigned int i = 0; i < LEVEL_PRELOAD_MAX; ++i)
+	{
+		LevelPreload *pPreload = sLevelPreload + i;
+
+		if (pPreload->fileName.empty())
+			continue;
+
+		pPreload->thread.join();
+		pPreload->fileName.clear();
+		LevelMapFree(&pPreload->map);
+	}
+}
+
+/******************************************************************************/
+/*!
+	AI for enemies using a state machine
+*/
+/******************************************************************************/
+void EnemyStateMachine(unsigned int inst)
+{
+	GameObjInst			*pInst	= gameObjInst(inst);
+	GameObjInstState	*pState	= gameObjInstState(inst);
+	AEVec2				*pVel	= gameObjInstVel(inst);
+
+	/*CONVERT COORDINATES TO CELL COORDINATES BY FLOORING VALUE*/
+	int currCellX = (int)(gameObjInstPos(inst)->x);
+	int currCellY = (int)(gameObjInstPos(inst)->y);
+
+	/*STATE MANAGER*/
+	switch (pState->state) {
+
+	/*GOING LEFT*/
+	case(STATE_GOING_LEFT):
+
+		switch (pState->innerState) {
+
+		case(INNER_STATE_ON_ENTER):
+
+			/*SET VELOCITY X TO MOVE LEFT*/
+			pVel->x	= -MOVE_VELOCITY_ENEMY;
+
+			/*UPDATE INNER STATE*/
+			pState->innerState	= INNER_STATE_ON_UPDATE;
+			break;
+
+		case(INNER_STATE_ON_UPDATE):
+
+			/*IF OBJECT COLLIDES WITH WALL OR IF THE OBJECT WILL FALL OFF PLATFORM*/
+			if (pInst->gridCollisionFlag & COLLISION_LEFT || 
+				0 == GetCellValue(currCellX - 1, currCellY - 1)) 
+			{
+				/*SET ENEMY TO IDLE BY SETTING VELOCITY X TO 0*/
+				pState->counter		= ENEMY_IDLE_TIME; // 2 seconds
+				pVel->x	= 0;
+
+				/*UPDATE STATE*/
+				pState->innerState	= INNER_STATE_ON_EXIT;
+			}
+			break;
+
+		case(INNER_STATE_ON_EXIT):
+
+			/*DECREMENT COUNTER BY FRAMETIME*/
+			pState->counter -= g_dt;
+
+			/*WHEN ENEMY IDLE TIMER IS UP*/
+			if (pState->counter < 0) {
+				/*UPDATE STATES*/
+				pState->state		= STATE_GOING_RIGHT;
+				pState->innerState	= INNER_STATE_ON_ENTER;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		break;
+		/*GOING LEFT END*/
+
+	/*GOING RIGHT*/
+	case(STATE_GOING_RIGHT):
+
+		switch (pState->innerState) {
+
+		case(INNER_STATE_ON_ENTER):
+
+			/*SET VELOCITY X TO MOVE RIGHT*/
+			pVel->x = MOVE_VELOCITY_ENEMY;
+
+			/*UPDATE INNER STATE*/
+			pState->innerState = INNER_STATE_ON_UPDATE;
+			break;
+
+		case(INNER_STATE_ON_UPDATE):
+
+			/*IF OBJECT COLLIDES WITH WALL OR IF THE OBJECT WILL FALL OFF PLATFORM*/
+			if (pInst->gridCollisionFlag & COLLISION_RIGHT ||
+				0 == GetCellValue(currCellX + 1, currCellY - 1))
+			{
+				/*SET ENEMY TO IDLE BY SETTING VELOCITY X TO 0*/
+				pState->counter = ENEMY_IDLE_TIME; // 2 seconds
+				pVel->x = 0;
+
+				/*UPDATE STATE*/
+				pState->innerState = INNER_STATE_ON_EXIT;
+			}
+			break;
+
+		case(INNER_STATE_ON_EXIT):
+
+			/*DECREMENT COUNTER BY FRAMETIME*/
+			pState->counter -= g_dt;
+
+			/*WHEN ENEMY IDLE TIMER IS UP*/
+			if (pState->counter < 0) {
+				/*UPDATE STATES*/
+				pState->state = STATE_GOING_LEFT;
+				pState->innerState = INNER_STATE_ON_ENTER;
+			}
+			break;
+
+		default:
+			break;
+		}
+
+		break;
+		/*GOING RIGHT END*/
+
+	default:
+		break;
+	}
+}
+
+/******************************************************************************/
+/*!
+	Creates a new particle
+*/
+/******************************************************************************/
+void CreateParticle(AEVec2 pos) {
+	for (unsigned int i = 0; i < PARTICLES_MAX; i++)
+	{
+		Particle *particle			= gParticlesList + i;
+
+		if (particle->flag == 0) {
+			// Create particle with randomized values
+			particle->pObject		= gGameObjList + TYPE_OBJECT_PARTICLE + (int)PRNG(0.f, 3.f); // Random particle 
+			particle->flag			= 1;
+			particle->transparency	= PRNG(TRANSPARENCY_MIN, TRANSPARENCY_MAX);
+			particle->scale			= PRNG(SCALE_MIN, SCALE_MAX);
+			particle->lifespan		= PRNG(LIFESPAN_MIN, LIFESPAN_MAX);
+			particle->velCurr		= PRNG(VELOCITY_MIN, VELOCITY_MAX);
+			particle->posCurr		= AEVec2{ pos.x + PRNG(-0.1f, 0.1f), pos.y + PRNG(0.2f, 0.4f) };
+			break;
+		}
+	}
+}
+
+/******************************************************************************/
+/*!
+	RNG calculation between two floating point values
+*/
+/******************************************************************************/
+f32 PRNG(f32 min, f32 max) {
+	int rng = (int)(min * 100) + (std::rand() % ((int)(max * 100) - (int)(min * 100) + 1));
+	return (f32)(rng / 100.f);
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+/******************************************************************************/
+/*!
+\file		TileGrid.cpp
+\author 	Ian Chua
+\par    	email: i.chua@digipen.edu
+\date   	February 28, 2023
+\brief		Tile map stored as one byte per cell in a single block.
+
+Copyright (C) 2023 DigiPen Institute of Technology.
+Reproduction or disclosure of this file or its contents without the
+prior written consent of DigiPen Institute of Technology is prohibited.
+ */
+ /******************************************************************************/
+
+#include "PlatformSim.h"
+
+/******************************************************************************/
+/*!
+	Allocates a width by height grid with every cell empty
+*/
+/******************************************************************************/
+bool TileGridInit(TileGrid *pGrid, int width, int height)
+{
+	size_t cellNum = (size_t)width * height;
+
+	pGrid->width	= width;
+	pGrid->height	= height;
+	pGrid->pCells	= (unsigned char*)calloc(cellNum ? cellNum : 1, sizeof(unsigned char));
+
+	return 0 != pGrid->pCells;
+}
+
+/******************************************************************************/
+/*!
+	Frees the grid
+*/
+/******************************************************************************/
+void TileGridFree(TileGrid *pGrid)
+{
+	free(pGrid->pCells);
+
+	pGrid->pCells	= 0;
+	pGrid->width	= 0;
+	pGrid->height	= 0;
+}
@@ -43,6 +43,10 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 
 	GameStateMgrInit(GS_MAIN);
 
+#if defined(DEBUG) | defined(_DEBUG)
+	f64 transitionStart = 0.0, transitionEnd;
+#endif
+
 	while (gGameStateCurr != GS_QUIT)
 	{
 		// reset the system modules
@@ -60,6 +64,12 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 		// Initialize the gamestate
 		GameStateInit();
 
+#if defined(DEBUG) | defined(_DEBUG)
+		// time spent between the last frame of the previous state and the first frame of this one
+		if (transitionStart > 0.0)
+			PRINT("State transition: %.3f ms\n", (AEGetTime(&transitionEnd) - transitionStart) * 1000.0);
+#endif
+
 		while (gGameStateCurr == gGameStateNext)
 		{
 			AESysFrameStart();
@@ -85,6 +95,10 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 			g_appTime += g_dt;
 		}
 
+#if defined(DEBUG) | defined(_DEBUG)
+		AEGetTime(&transitionStart);
+#endif
+
 		GameStateFree();
 
 		if (gGameStateNext != GS_RESTART)
@@ -97,6 +111,12 @@ int WINAPI WinMain(HINSTANCE instanceH, HINSTANCE prevInstanceH, LPSTR command_l
 	//free you font here
 	AEGfxDestroyFont(fontId);
 
+	//wait for the levels still being read in the background
+	GameStatePlatformPreloadFree();
+
+	//free the meshes shared by the levels
+	MeshCacheFree();
+
 	// free the system
 	AESysExit();
 }
\ No newline at end of file